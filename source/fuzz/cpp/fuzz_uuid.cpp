@@ -0,0 +1,67 @@
+#include "cbase/c_runes.h"
+#include "cuuid/c_uuid.h"
+
+// libFuzzer entry point for the uuid_t parse/format/serialize paths, build with e.g.:
+//   clang++ -g -O1 -fsanitize=fuzzer,address -Isource/main/include <dependency include paths>
+//           source/fuzz/cpp/fuzz_uuid.cpp source/main/cpp/c_uuid.cpp <dependency libraries>
+// Any violated property traps, so the fuzzer reports it as a crash.
+
+using namespace ncore;
+
+#define FUZZ_CHECK(expr) \
+    if (!(expr))         \
+    __builtin_trap()
+
+extern "C" int LLVMFuzzerTestOneInput(const u8* data, size_t size)
+{
+    // The input as 16 bytes in network byte order
+    if (size >= 16)
+    {
+        uuid_t id;
+        id.copyFrom(data);
+
+        u8 bytes[16];
+        id.copyTo(bytes);
+        for (s32 i = 0; i < 16; ++i)
+            FUZZ_CHECK(bytes[i] == data[i]);
+        FUZZ_CHECK(s32(id.version()) == (data[6] >> 4));
+
+        char str[37];
+        id.toChars(str);
+        str[36] = 0;
+
+        uuid_t parsed;
+        FUZZ_CHECK(parsed.tryParse(str));
+        FUZZ_CHECK(parsed == id);
+        FUZZ_CHECK(parsed.upper() == id.upper() && parsed.lower() == id.lower());
+    }
+
+    // The input as text
+    char text[64];
+    s32  len = 0;
+    while (len < 63 && len < (s32)size && data[len] != 0)
+    {
+        text[len] = (char)data[len];
+        ++len;
+    }
+    text[len] = 0;
+
+    uuid_t id;
+    uuid_t const before = id;
+    if (id.tryParse(text))
+    {
+        // Whatever was accepted must format back to the same value
+        char str[37];
+        id.toChars(str);
+        str[36] = 0;
+
+        uuid_t reparsed;
+        FUZZ_CHECK(reparsed.tryParse(str));
+        FUZZ_CHECK(reparsed == id);
+    }
+    else
+    {
+        FUZZ_CHECK(id == before);
+    }
+    return 0;
+}
@@ -25,7 +25,15 @@ namespace ncore
         _mac = uuid._mac;
     }
 
-    uuid_t::uuid_t(const char* uuid) { tryParse(uuid); }
+    uuid_t::uuid_t(const char* uuid)
+        : _timeLow(0)
+        , _timeMid(0)
+        , _timeHiAndVersion(0)
+        , _clockSeq(0)
+    {
+        _mac.clear();
+        tryParse(uuid);
+    }
 
     uuid_t::uuid_t(u32 timeLow, u32 timeMid, u32 timeHiAndVersion, u16 clockSeq, mac_t node)
         : _timeLow(timeLow)
@@ -103,31 +111,41 @@ namespace ncore
         if (str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-')
             return false;
 
-        uchar const* it = str;
+        // Decode all 32 hex digits before touching the members, so that a
+        // failed parse leaves the uuid_t unchanged.
+        u8  digits[32];
+        s32 n = 0;
+        for (s32 i = 0; i < 36; ++i)
+        {
+            if (i == 8 || i == 13 || i == 18 || i == 23)
+                continue;
+            u8 const d = nibble(str[i]);
+            if (d > 0xF)
+                return false;
+            digits[n++] = d;
+        }
+
+        u8 const* it = digits;
 
         _timeLow = 0;
         for (s32 i = 0; i < 8; ++i)
-            _timeLow = (_timeLow << 4) | nibble(*it++);
+            _timeLow = (_timeLow << 4) | *it++;
 
-        ++it;
         _timeMid = 0;
         for (s32 i = 0; i < 4; ++i)
-            _timeMid = (_timeMid << 4) | nibble(*it++);
+            _timeMid = (_timeMid << 4) | *it++;
 
-        ++it;
         _timeHiAndVersion = 0;
         for (s32 i = 0; i < 4; ++i)
-            _timeHiAndVersion = (_timeHiAndVersion << 4) | nibble(*it++);
+            _timeHiAndVersion = (_timeHiAndVersion << 4) | *it++;
 
-        ++it;
         _clockSeq = 0;
         for (s32 i = 0; i < 4; ++i)
-            _clockSeq = (_clockSeq << 4) | nibble(*it++);
+            _clockSeq = (_clockSeq << 4) | *it++;
 
-        ++it;
         for (s32 i = 0; i < 6; ++i)
         {
-            _mac.m_data[i] = (nibble(it[0]) << 4) | nibble(it[1]);
+            _mac.m_data[i] = (it[0] << 4) | it[1];
             it += 2;
         }
 
@@ -136,18 +154,29 @@ namespace ncore
 
     void uuid_t::toString(runes_t& str) const
     {
-        if (str.cap() >= 24)
-        {
-            crunes_t format("%08X-%04X-%04X-%04X-");
-            sprintf(str, format, va_t(_timeLow), va_t(_timeMid), va_t(_timeHiAndVersion), va_t(_clockSeq));
-        }
-        if (str.cap() >= (24 + 36))
+        if (str.cap() >= 36)
         {
-            crunes_t format("%02X%02X%02X%02X%02X%02X");
-            sprintf(str, format, va_t(_mac.m_data[0]), va_t(_mac.m_data[1]), va_t(_mac.m_data[2]), va_t(_mac.m_data[3]), va_t(_mac.m_data[4]), va_t(_mac.m_data[5]));
+            crunes_t fields("%08X-%04X-%04X-%04X-");
+            sprintf(str, fields, va_t(_timeLow), va_t(_timeMid), va_t(_timeHiAndVersion), va_t(_clockSeq));
+            crunes_t node("%02X%02X%02X%02X%02X%02X");
+            sprintf(str, node, va_t(_mac.m_data[0]), va_t(_mac.m_data[1]), va_t(_mac.m_data[2]), va_t(_mac.m_data[3]), va_t(_mac.m_data[4]), va_t(_mac.m_data[5]));
         }
     }
 
+    void uuid_t::toChars(char* str) const
+    {
+        str    = appendHex(str, _timeLow);
+        *str++ = '-';
+        str    = appendHex(str, _timeMid);
+        *str++ = '-';
+        str    = appendHex(str, _timeHiAndVersion);
+        *str++ = '-';
+        str    = appendHex(str, _clockSeq);
+        *str++ = '-';
+        for (s32 i = 0; i < 6; ++i)
+            str = appendHex(str, _mac.m_data[i]);
+    }
+
     inline u32 from_bytes(const u8* bytes, u32 i, u32& value)
     {
         u32 dst32;
@@ -185,7 +214,7 @@ namespace ncore
         _clockSeq         = nendian_ne::swap(i16);
 
         for (s32 i = 0; i < 6; ++i)
-            _mac.m_data[i] = bytes[i];
+            _mac.m_data[i] = bytes[idx + i];
     }
 
     inline u32 to_bytes(u8* bytes, u32 idx, u32 value)
@@ -206,17 +235,14 @@ namespace ncore
 
     void uuid_t::copyTo(u8* bytes) const
     {
+        // to_bytes() already writes in network byte order
         u32 idx = 0;
-        u32 i32 = nendian_ne::swap(_timeLow);
-        idx     = to_bytes(bytes, idx, i32);
-        u32 i16 = nendian_ne::swap(_timeMid);
-        idx     = to_bytes(bytes, idx, i16);
-        i16     = nendian_ne::swap(_timeHiAndVersion);
-        idx     = to_bytes(bytes, idx, i16);
-        i16     = nendian_ne::swap(_clockSeq);
-        idx     = to_bytes(bytes, idx, i16);
-		for (s32 i = 0; i < 6; ++i)
-			bytes[idx++] = _mac.m_data[i];
+        idx     = to_bytes(bytes, idx, _timeLow);
+        idx     = to_bytes(bytes, idx, _timeMid);
+        idx     = to_bytes(bytes, idx, _timeHiAndVersion);
+        idx     = to_bytes(bytes, idx, _clockSeq);
+        for (s32 i = 0; i < 6; ++i)
+            bytes[idx++] = _mac.m_data[i];
     }
 
     s32 uuid_t::variant() const
@@ -246,9 +272,9 @@ namespace ncore
 
     char* uuid_t::appendHex(char* str, u8 n)
     {
-        const char* digits = "0123456789abcdef";
-        str += digits[(n >> 4) & 0xF];
-        str += digits[n & 0xF];
+        const char* digits = "0123456789ABCDEF";
+        *str++             = digits[(n >> 4) & 0xF];
+        *str++             = digits[n & 0xF];
         return str;
     }
 
@@ -275,7 +301,7 @@ namespace ncore
         else if (hex >= '0' && hex <= '9')
             return u8(hex - '0');
         else
-            return u8(0);
+            return u8(0xFF);
     }
 
     void uuid_t::fromNetwork()
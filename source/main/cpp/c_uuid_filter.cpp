@@ -0,0 +1,576 @@
+#include "ccore/c_debug.h"
+#include "cbase/c_allocator.h"
+#include "cuuid/c_uuid_filter.h"
+
+#include <math.h>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#    define CUUID_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#    define CUUID_PREFETCH(ptr) __builtin_prefetch((const void*)(ptr))
+#endif
+
+namespace ncore
+{
+    namespace nfilter
+    {
+        static const u32 cBloomMagic     = 0x46425543;  // 'CUBF'
+        static const u32 cFuseMagic      = 0x46465543;  // 'CUFF'
+        static const u32 cVersion        = 1;
+        static const u32 cHeaderSize     = 64;
+        static const u32 cBlockWords     = 8;
+        static const u32 cMaxSegment     = 262144;
+        static const s32 cBatchLookahead = 8;
+
+        // Serialized header, padded to a cache line so that the payload that
+        // follows it stays cache-line aligned in a memory-mapped file.
+        struct header_t
+        {
+            u32 m_magic;
+            u32 m_version;
+            u64 m_seed;
+            u64 m_count;
+            u32 m_segmentLength;
+            u32 m_segmentCount;
+            u32 m_arrayLength;
+            u32 m_reserved[7];
+        };
+
+        inline u64 mulhi(u64 a, u64 b)
+        {
+#if defined(_MSC_VER)
+            return __umulh(a, b);
+#else
+            return (u64)(((unsigned __int128)a * (unsigned __int128)b) >> 64);
+#endif
+        }
+
+        inline u64 murmur64(u64 h)
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        inline u64 splitmix64(u64& state)
+        {
+            u64 z = (state += 0x9E3779B97F4A7C15ull);
+            z     = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z     = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // Odd constants of the split block Bloom filter, each one selects
+        // the bit to set in one of the 8 words of a block.
+        static const u32 cSalt[cBlockWords] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+        inline u8 fingerprint(u64 hash) { return (u8)(hash ^ (hash >> 32)); }
+
+        inline u32 mod3(u32 x) { return x > 2 ? x - 3 : x; }
+
+        // The largest scratch array in uuid_fuse_filter::build() holds 8 bytes per
+        // fingerprint slot (~1.13 slots per key), which has to stay below the
+        // 4 GB that alloc_t can hand out in a single allocation.
+        static const u32 cFuseMaxCount = 470000000;
+
+        template <typename T>
+        inline T* allocate(alloc_t* allocator, u64 count)
+        {
+            if ((count * sizeof(T)) >= 0xFFFFFFFFull)
+                return nullptr;
+            return (T*)allocator->allocate((u32)(count * sizeof(T)), 64);
+        }
+
+        inline void deallocate(alloc_t* allocator, void* ptr)
+        {
+            if (ptr != nullptr)
+                allocator->deallocate(ptr);
+        }
+
+        template <typename T>
+        inline void clear(T* array, u64 count)
+        {
+            for (u64 i = 0; i < count; ++i)
+                array[i] = 0;
+        }
+    }  // namespace nfilter
+
+    // ------------------------------------------------------------------------
+    // uuid_bloom_filter
+    // ------------------------------------------------------------------------
+
+    uuid_bloom_filter::uuid_bloom_filter()
+        : _allocator(nullptr)
+        , _blocks(nullptr)
+        , _numBlocks(0)
+        , _owned(false)
+    {
+    }
+
+    uuid_bloom_filter::~uuid_bloom_filter() { release(); }
+
+    bool uuid_bloom_filter::init(alloc_t* allocator, u64 expectedCount, u32 bitsPerItem)
+    {
+        release();
+
+        u64 const numBits = (expectedCount == 0 ? 1 : expectedCount) * (bitsPerItem == 0 ? 1 : bitsPerItem);
+        _numBlocks        = (numBits + 511) / 512;
+        _allocator        = allocator;
+        _blocks           = nfilter::allocate<u64>(allocator, _numBlocks * nfilter::cBlockWords);
+        if (_blocks == nullptr)
+        {
+            _numBlocks = 0;
+            return false;
+        }
+        _owned = true;
+        clear();
+        return true;
+    }
+
+    void uuid_bloom_filter::release()
+    {
+        if (_owned && _blocks != nullptr)
+            _allocator->deallocate(_blocks);
+        _blocks    = nullptr;
+        _numBlocks = 0;
+        _owned     = false;
+    }
+
+    void uuid_bloom_filter::clear()
+    {
+        ASSERT(_owned);
+        nfilter::clear(_blocks, _numBlocks * nfilter::cBlockWords);
+    }
+
+    void uuid_bloom_filter::insert(const uuid_t& id)
+    {
+        ASSERT(_owned);
+        u64 const h     = id.hash();
+        u64*      block = _blocks + nfilter::mulhi(h, _numBlocks) * nfilter::cBlockWords;
+        u32 const key   = (u32)h;
+        for (u32 i = 0; i < nfilter::cBlockWords; ++i)
+            block[i] |= (u64)1 << ((key * nfilter::cSalt[i]) >> 26);
+    }
+
+    bool uuid_bloom_filter::contains(const uuid_t& id) const
+    {
+        if (_numBlocks == 0)
+            return false;
+
+        u64 const  h     = id.hash();
+        u64 const* block = _blocks + nfilter::mulhi(h, _numBlocks) * nfilter::cBlockWords;
+        u32 const  key   = (u32)h;
+        u64        miss  = 0;
+        for (u32 i = 0; i < nfilter::cBlockWords; ++i)
+            miss |= ~block[i] & ((u64)1 << ((key * nfilter::cSalt[i]) >> 26));
+        return miss == 0;
+    }
+
+    void uuid_bloom_filter::containsBatch(const uuid_t* ids, s32 count, bool* results) const
+    {
+        if (_numBlocks == 0)
+        {
+            for (s32 i = 0; i < count; ++i)
+                results[i] = false;
+            return;
+        }
+
+        for (s32 i = 0; i < count && i < nfilter::cBatchLookahead; ++i)
+            CUUID_PREFETCH(_blocks + nfilter::mulhi(ids[i].hash(), _numBlocks) * nfilter::cBlockWords);
+
+        for (s32 i = 0; i < count; ++i)
+        {
+            s32 const ahead = i + nfilter::cBatchLookahead;
+            if (ahead < count)
+                CUUID_PREFETCH(_blocks + nfilter::mulhi(ids[ahead].hash(), _numBlocks) * nfilter::cBlockWords);
+            results[i] = contains(ids[i]);
+        }
+    }
+
+    u64 uuid_bloom_filter::serializedSize() const { return nfilter::cHeaderSize + _numBlocks * nfilter::cBlockWords * sizeof(u64); }
+
+    void uuid_bloom_filter::serialize(u8* buffer) const
+    {
+        nfilter::header_t header;
+        nfilter::clear((u8*)&header, sizeof(header));
+        header.m_magic   = nfilter::cBloomMagic;
+        header.m_version = nfilter::cVersion;
+        header.m_count   = _numBlocks;
+
+        u8 const* src = (u8 const*)&header;
+        for (u32 i = 0; i < nfilter::cHeaderSize; ++i)
+            *buffer++ = *src++;
+
+        src = (u8 const*)_blocks;
+        for (u64 i = 0; i < _numBlocks * nfilter::cBlockWords * sizeof(u64); ++i)
+            *buffer++ = *src++;
+    }
+
+    bool uuid_bloom_filter::attach(const u8* buffer, u64 size)
+    {
+        if (size < nfilter::cHeaderSize || ((u64)buffer & 63) != 0)
+            return false;
+
+        nfilter::header_t const* header = (nfilter::header_t const*)buffer;
+        if (header->m_magic != nfilter::cBloomMagic || header->m_version != nfilter::cVersion || header->m_count == 0)
+            return false;
+        // Divide instead of multiply, a corrupt count must not wrap the size check
+        if (header->m_count > (size - nfilter::cHeaderSize) / (nfilter::cBlockWords * sizeof(u64)))
+            return false;
+
+        release();
+        _blocks    = (u64*)(buffer + nfilter::cHeaderSize);
+        _numBlocks = header->m_count;
+        _owned     = false;
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // uuid_fuse_filter
+    //
+    // Construction follows 'Binary Fuse Filters: Fast and Smaller Than Xor
+    // Filters' (Graf & Lemire, 2022) with arity 3.
+    // ------------------------------------------------------------------------
+
+    uuid_fuse_filter::uuid_fuse_filter()
+        : _allocator(nullptr)
+        , _fingerprints(nullptr)
+        , _seed(0)
+        , _segmentLength(0)
+        , _segmentLengthMask(0)
+        , _segmentCount(0)
+        , _segmentCountLength(0)
+        , _arrayLength(0)
+        , _owned(false)
+    {
+    }
+
+    uuid_fuse_filter::~uuid_fuse_filter() { release(); }
+
+    void uuid_fuse_filter::release()
+    {
+        if (_owned && _fingerprints != nullptr)
+            _allocator->deallocate(_fingerprints);
+        _fingerprints = nullptr;
+        _arrayLength  = 0;
+        _owned        = false;
+    }
+
+    void uuid_fuse_filter::layout(u32 count)
+    {
+        u32 const arity = 3;
+
+        _segmentLength = count == 0 ? 4 : (u32)1 << (s32)floor(log((double)count) / log(3.33) + 2.25);
+        if (_segmentLength > nfilter::cMaxSegment)
+            _segmentLength = nfilter::cMaxSegment;
+        _segmentLengthMask = _segmentLength - 1;
+
+        double const sizeFactor = count <= 1 ? 0.0 : (1.125 > 0.875 + 0.25 * log(1000000.0) / log((double)count) ? 1.125 : 0.875 + 0.25 * log(1000000.0) / log((double)count));
+        u32 const    capacity   = count <= 1 ? 0 : (u32)(round((double)count * sizeFactor));
+
+        u32 const initSegmentCount = (capacity + _segmentLength - 1) / _segmentLength - (arity - 1);
+        _arrayLength               = (initSegmentCount + arity - 1) * _segmentLength;
+        _segmentCount              = (_arrayLength + _segmentLength - 1) / _segmentLength;
+        _segmentCount              = _segmentCount <= arity - 1 ? 1 : _segmentCount - (arity - 1);
+        _arrayLength               = (_segmentCount + arity - 1) * _segmentLength;
+        _segmentCountLength        = _segmentCount * _segmentLength;
+    }
+
+    inline void uuid_fuse_filter::positions(u64 hash, u32& h0, u32& h1, u32& h2) const
+    {
+        h0 = (u32)nfilter::mulhi(hash, _segmentCountLength);
+        h1 = h0 + _segmentLength;
+        h2 = h1 + _segmentLength;
+        h1 ^= (u32)(hash >> 18) & _segmentLengthMask;
+        h2 ^= (u32)hash & _segmentLengthMask;
+    }
+
+    bool uuid_fuse_filter::build(alloc_t* allocator, const uuid_t* ids, u32 count)
+    {
+        release();
+        if (count > nfilter::cFuseMaxCount)
+            return false;
+        layout(count);
+
+        _allocator    = allocator;
+        _fingerprints = nfilter::allocate<u8>(allocator, _arrayLength);
+        if (_fingerprints == nullptr)
+            return false;
+        _owned = true;
+        nfilter::clear(_fingerprints, _arrayLength);
+        if (count == 0)
+            return true;
+
+        u32 const capacity = _arrayLength;
+        u32       size     = count;
+
+        u64* reverseOrder = nfilter::allocate<u64>(allocator, size + 1);
+        u32* alone        = nfilter::allocate<u32>(allocator, capacity);
+        u8*  t2count      = nfilter::allocate<u8>(allocator, capacity);
+        u8*  reverseH     = nfilter::allocate<u8>(allocator, size);
+        u64* t2hash       = nfilter::allocate<u64>(allocator, capacity);
+
+        u32 blockBits = 1;
+        while (((u32)1 << blockBits) < _segmentCount)
+            blockBits++;
+        u32 const block    = (u32)1 << blockBits;
+        u32*      startPos = nfilter::allocate<u32>(allocator, block);
+
+        if (reverseOrder == nullptr || alone == nullptr || t2count == nullptr || reverseH == nullptr || t2hash == nullptr || startPos == nullptr)
+        {
+            nfilter::deallocate(allocator, startPos);
+            nfilter::deallocate(allocator, t2hash);
+            nfilter::deallocate(allocator, reverseH);
+            nfilter::deallocate(allocator, t2count);
+            nfilter::deallocate(allocator, alone);
+            nfilter::deallocate(allocator, reverseOrder);
+            release();
+            return false;
+        }
+
+        nfilter::clear(reverseOrder, size);
+        reverseOrder[size] = 1;
+        nfilter::clear(t2count, capacity);
+        nfilter::clear(t2hash, capacity);
+
+        u64 rng   = 0x726b2b9d438b9d4dull;
+        _seed     = nfilter::splitmix64(rng);
+        bool done = false;
+
+        u32 h012[5];
+        for (s32 attempt = 0; attempt < 100; ++attempt)
+        {
+            for (u32 i = 0; i < block; i++)
+                startPos[i] = (u32)(((u64)i * size) >> blockBits);
+
+            u32 const maskBlock = block - 1;
+            for (u32 i = 0; i < size; i++)
+            {
+                u64 const hash         = nfilter::murmur64(ids[i].hash() + _seed);
+                u64       segmentIndex = hash >> (64 - blockBits);
+                while (reverseOrder[startPos[segmentIndex]] != 0)
+                {
+                    segmentIndex++;
+                    segmentIndex &= maskBlock;
+                }
+                reverseOrder[startPos[segmentIndex]] = hash;
+                startPos[segmentIndex]++;
+            }
+
+            bool error      = false;
+            u32  duplicates = 0;
+            for (u32 i = 0; i < size; i++)
+            {
+                u64 const hash = reverseOrder[i];
+                u32       h0, h1, h2;
+                positions(hash, h0, h1, h2);
+                t2count[h0] += 4;
+                t2hash[h0] ^= hash;
+                t2count[h1] += 4;
+                t2count[h1] ^= 1;
+                t2hash[h1] ^= hash;
+                t2count[h2] += 4;
+                t2count[h2] ^= 2;
+                t2hash[h2] ^= hash;
+
+                // A duplicate key cancels itself out in all three cells, undo it.
+                if ((t2hash[h0] & t2hash[h1] & t2hash[h2]) == 0)
+                {
+                    if (((t2hash[h0] == 0) && (t2count[h0] == 8)) || ((t2hash[h1] == 0) && (t2count[h1] == 8)) || ((t2hash[h2] == 0) && (t2count[h2] == 8)))
+                    {
+                        duplicates++;
+                        t2count[h0] -= 4;
+                        t2hash[h0] ^= hash;
+                        t2count[h1] -= 4;
+                        t2count[h1] ^= 1;
+                        t2hash[h1] ^= hash;
+                        t2count[h2] -= 4;
+                        t2count[h2] ^= 2;
+                        t2hash[h2] ^= hash;
+                    }
+                }
+                error = (t2count[h0] < 4) || (t2count[h1] < 4) || (t2count[h2] < 4) || error;
+            }
+
+            if (!error)
+            {
+                // Peel, starting from the cells that hold a single key.
+                u32 qsize = 0;
+                for (u32 i = 0; i < capacity; i++)
+                {
+                    alone[qsize] = i;
+                    qsize += ((t2count[i] >> 2) == 1) ? 1 : 0;
+                }
+
+                u32 stackSize = 0;
+                while (qsize > 0)
+                {
+                    qsize--;
+                    u32 const index = alone[qsize];
+                    if ((t2count[index] >> 2) == 1)
+                    {
+                        u64 const hash  = t2hash[index];
+                        u8 const  found = t2count[index] & 3;
+                        reverseH[stackSize]     = found;
+                        reverseOrder[stackSize] = hash;
+                        stackSize++;
+
+                        positions(hash, h012[0], h012[1], h012[2]);
+                        h012[3] = h012[0];
+                        h012[4] = h012[1];
+
+                        u32 const other1 = h012[found + 1];
+                        alone[qsize]     = other1;
+                        qsize += ((t2count[other1] >> 2) == 2 ? 1 : 0);
+                        t2count[other1] -= 4;
+                        t2count[other1] ^= nfilter::mod3(found + 1);
+                        t2hash[other1] ^= hash;
+
+                        u32 const other2 = h012[found + 2];
+                        alone[qsize]     = other2;
+                        qsize += ((t2count[other2] >> 2) == 2 ? 1 : 0);
+                        t2count[other2] -= 4;
+                        t2count[other2] ^= nfilter::mod3(found + 2);
+                        t2hash[other2] ^= hash;
+                    }
+                }
+
+                if (stackSize + duplicates == size)
+                {
+                    size = stackSize;
+                    done = true;
+                    break;
+                }
+            }
+
+            nfilter::clear(reverseOrder, size);
+            nfilter::clear(t2count, capacity);
+            nfilter::clear(t2hash, capacity);
+            _seed = nfilter::splitmix64(rng);
+        }
+
+        if (done)
+        {
+            for (u32 i = size - 1; i < size; i--)
+            {
+                u64 const hash  = reverseOrder[i];
+                u8 const  xor2  = nfilter::fingerprint(hash);
+                u8 const  found = reverseH[i];
+                positions(hash, h012[0], h012[1], h012[2]);
+                h012[3] = h012[0];
+                h012[4] = h012[1];
+                _fingerprints[h012[found]] = xor2 ^ _fingerprints[h012[found + 1]] ^ _fingerprints[h012[found + 2]];
+            }
+        }
+
+        allocator->deallocate(startPos);
+        allocator->deallocate(t2hash);
+        allocator->deallocate(reverseH);
+        allocator->deallocate(t2count);
+        allocator->deallocate(alone);
+        allocator->deallocate(reverseOrder);
+
+        if (!done)
+            release();
+        return done;
+    }
+
+    bool uuid_fuse_filter::contains(const uuid_t& id) const
+    {
+        if (_fingerprints == nullptr || _segmentCountLength == 0)
+            return false;
+
+        u64 const hash = nfilter::murmur64(id.hash() + _seed);
+        u32       h0, h1, h2;
+        positions(hash, h0, h1, h2);
+        return (nfilter::fingerprint(hash) ^ _fingerprints[h0] ^ _fingerprints[h1] ^ _fingerprints[h2]) == 0;
+    }
+
+    void uuid_fuse_filter::containsBatch(const uuid_t* ids, s32 count, bool* results) const
+    {
+        if (_fingerprints == nullptr || _segmentCountLength == 0)
+        {
+            for (s32 i = 0; i < count; ++i)
+                results[i] = false;
+            return;
+        }
+
+        // Hash a group, prefetch all of its cells, then resolve the group
+        // while the next one is being hashed and prefetched.
+        u64 hashes[nfilter::cBatchLookahead];
+        u32 cells[nfilter::cBatchLookahead][3];
+        for (s32 base = 0; base < count; base += nfilter::cBatchLookahead)
+        {
+            s32 const n = (count - base) < nfilter::cBatchLookahead ? (count - base) : nfilter::cBatchLookahead;
+            for (s32 j = 0; j < n; ++j)
+            {
+                hashes[j] = nfilter::murmur64(ids[base + j].hash() + _seed);
+                positions(hashes[j], cells[j][0], cells[j][1], cells[j][2]);
+                CUUID_PREFETCH(_fingerprints + cells[j][0]);
+                CUUID_PREFETCH(_fingerprints + cells[j][1]);
+                CUUID_PREFETCH(_fingerprints + cells[j][2]);
+            }
+            for (s32 j = 0; j < n; ++j)
+                results[base + j] = (nfilter::fingerprint(hashes[j]) ^ _fingerprints[cells[j][0]] ^ _fingerprints[cells[j][1]] ^ _fingerprints[cells[j][2]]) == 0;
+        }
+    }
+
+    u64 uuid_fuse_filter::serializedSize() const { return nfilter::cHeaderSize + _arrayLength; }
+
+    void uuid_fuse_filter::serialize(u8* buffer) const
+    {
+        nfilter::header_t header;
+        nfilter::clear((u8*)&header, sizeof(header));
+        header.m_magic         = nfilter::cFuseMagic;
+        header.m_version       = nfilter::cVersion;
+        header.m_seed          = _seed;
+        header.m_count         = _segmentCountLength;
+        header.m_segmentLength = _segmentLength;
+        header.m_segmentCount  = _segmentCount;
+        header.m_arrayLength   = _arrayLength;
+
+        u8 const* src = (u8 const*)&header;
+        for (u32 i = 0; i < nfilter::cHeaderSize; ++i)
+            *buffer++ = *src++;
+
+        for (u32 i = 0; i < _arrayLength; ++i)
+            *buffer++ = _fingerprints[i];
+    }
+
+    bool uuid_fuse_filter::attach(const u8* buffer, u64 size)
+    {
+        if (size < nfilter::cHeaderSize || ((u64)buffer & 7) != 0)
+            return false;
+
+        nfilter::header_t const* header = (nfilter::header_t const*)buffer;
+        if (header->m_magic != nfilter::cFuseMagic || header->m_version != nfilter::cVersion)
+            return false;
+        if (header->m_segmentLength == 0 || header->m_segmentLength > nfilter::cMaxSegment || (header->m_segmentLength & (header->m_segmentLength - 1)) != 0)
+            return false;
+
+        // Checked in 64 bits, a corrupt header must not wrap the lengths that
+        // positions() relies on to stay inside the fingerprints.
+        if (header->m_count > 0xFFFFFFFFull || header->m_count != (u64)header->m_segmentCount * header->m_segmentLength)
+            return false;
+        if ((u64)header->m_arrayLength != ((u64)header->m_segmentCount + 2) * header->m_segmentLength)
+            return false;
+        if (size < nfilter::cHeaderSize + (u64)header->m_arrayLength)
+            return false;
+
+        release();
+        _fingerprints       = (u8*)(buffer + nfilter::cHeaderSize);
+        _seed               = header->m_seed;
+        _segmentLength      = header->m_segmentLength;
+        _segmentLengthMask  = header->m_segmentLength - 1;
+        _segmentCount       = header->m_segmentCount;
+        _segmentCountLength = (u32)header->m_count;
+        _arrayLength        = header->m_arrayLength;
+        _owned              = false;
+        return true;
+    }
+
+}  // namespace ncore
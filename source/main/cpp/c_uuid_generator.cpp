@@ -3,8 +3,101 @@
 #include "cuuid/c_uuid_generator.h"
 #include "chash/c_hash.h"
 
+#include <atomic>
+
+#if defined(TARGET_PC)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif defined(TARGET_MAC) || defined(TARGET_LINUX)
+#	include <fcntl.h>
+#	include <pthread.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
 namespace ncore
 {
+	// Layout of the (memory-mapped) state file
+	struct uuid_state_t
+	{
+		u32   m_magic;
+		u32   m_version;
+		u64   m_lastTime;
+		u16   m_clockSeq;
+		mac_t m_node;
+		u8    m_reserved[8];
+	};
+
+	namespace nstate
+	{
+		static const u32 cMagic   = 0x53555543; // 'CUUS'
+		static const u32 cVersion = 1;
+
+		// Bumped in the child after a fork and when the application reports a
+		// snapshot restore, generators compare it against their own copy.
+		static std::atomic<u32> sGeneration(1);
+
+#if defined(TARGET_MAC) || defined(TARGET_LINUX)
+		static void onForkChild() { sGeneration.fetch_add(1, std::memory_order_relaxed); }
+
+		static bool registerForkHandler()
+		{
+			pthread_atfork(nullptr, nullptr, onForkChild);
+			return true;
+		}
+#else
+		static bool registerForkHandler() { return true; }
+#endif
+
+		inline u32 generation()
+		{
+			static const bool registered = registerForkHandler();
+			(void)registered;
+			return sGeneration.load(std::memory_order_relaxed);
+		}
+
+		static uuid_state_t* map(const char* path)
+		{
+#if defined(TARGET_PC)
+			HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (file == INVALID_HANDLE_VALUE)
+				return nullptr;
+			HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, 0, sizeof(uuid_state_t), NULL);
+			CloseHandle(file);
+			if (mapping == NULL)
+				return nullptr;
+			void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(uuid_state_t));
+			CloseHandle(mapping);
+			return (uuid_state_t*)view;
+#elif defined(TARGET_MAC) || defined(TARGET_LINUX)
+			int fd = open(path, O_RDWR | O_CREAT, 0644);
+			if (fd < 0)
+				return nullptr;
+			struct stat st;
+			if (fstat(fd, &st) != 0 || (st.st_size < (off_t)sizeof(uuid_state_t) && ftruncate(fd, sizeof(uuid_state_t)) != 0))
+			{
+				close(fd);
+				return nullptr;
+			}
+			void* view = mmap(nullptr, sizeof(uuid_state_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			close(fd);
+			return view == MAP_FAILED ? nullptr : (uuid_state_t*)view;
+#else
+			return nullptr;
+#endif
+		}
+
+		static void unmap(uuid_state_t* state)
+		{
+#if defined(TARGET_PC)
+			UnmapViewOfFile(state);
+#elif defined(TARGET_MAC) || defined(TARGET_LINUX)
+			munmap(state, sizeof(uuid_state_t));
+#endif
+		}
+	} // namespace nstate
+
 	class xuuid_ : public uuid_t
 	{
 	public:
@@ -16,24 +109,100 @@ namespace ncore
 
 	uuid_generator::uuid_generator()
 		: _initialized(false)
-		, _ticks(0)
 		, _haveMac(false)
+		, _ticks(0)
+		, _generation(0)
+		, _clockSeq(0)
+		, _state(nullptr)
 	{
 	}
 
 	uuid_generator::~uuid_generator()
 	{
+		detachStateFile();
 	}
-	 
+
 	void uuid_generator::init()
 	{
-		_random.reset();
+		if (_initialized && _generation == nstate::generation())
+			return;
+
 		if (!_haveMac)
 		{
 			_mac.clear();
 			//xsystem::get_mac_address(_mac);
 			_haveMac = true;
 		}
+
+		// First use, or the process was forked or restored from a snapshot,
+		// in which case another process carries the same state.
+		reseed();
+		_initialized = true;
+	}
+
+	void uuid_generator::reseed()
+	{
+		_generation = nstate::generation();
+
+		u8 entropy[8];
+		nrnd::randBuffer(entropy, 8);
+		s64 seed = 0;
+		for (s32 i = 0; i < 8; ++i)
+			seed = (seed << 8) | entropy[i];
+		_random.reset(seed);
+
+		// RFC 4122 4.2.1, the previous clock sequence cannot be trusted, pick a new random one.
+		// Never the old one, another process (parent or snapshot) may still be using it.
+		_clockSeq = u16(_clockSeq + 1 + (_random.generate() % 0x3FFF)) & 0x3FFF;
+		_lastTime = datetime_t();
+		_ticks    = 0;
+		if (_state != nullptr)
+			_state->m_clockSeq = _clockSeq;
+	}
+
+	bool uuid_generator::attachStateFile(const char* path)
+	{
+		detachStateFile();
+		init();
+
+		uuid_state_t* state = nstate::map(path);
+		if (state == nullptr)
+			return false;
+
+		if (state->m_magic == nstate::cMagic && state->m_version == nstate::cVersion && mac_t::compare(state->m_node, _mac) == 0)
+		{
+			// Same node, continue the stored clock sequence and advance it if the
+			// clock is now behind the last timestamp we handed out.
+			_clockSeq = state->m_clockSeq & 0x3FFF;
+			if (u64(datetime_t::sNow().toBinary()) <= state->m_lastTime)
+				_clockSeq = (_clockSeq + 1) & 0x3FFF;
+		}
+		else
+		{
+			// No (valid) state or the node changed, keep our random clock sequence
+			state->m_magic    = nstate::cMagic;
+			state->m_version  = nstate::cVersion;
+			state->m_lastTime = 0;
+			state->m_node     = _mac;
+		}
+		state->m_clockSeq = _clockSeq;
+
+		_state = state;
+		return true;
+	}
+
+	void uuid_generator::detachStateFile()
+	{
+		if (_state != nullptr)
+		{
+			nstate::unmap(_state);
+			_state = nullptr;
+		}
+	}
+
+	void uuid_generator::notifySnapshotRestored()
+	{
+		nstate::sGeneration.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	uuid_t uuid_generator::create()
@@ -47,7 +216,7 @@ namespace ncore
 		u32 timeLow = u32(tv & 0xFFFFFFFF);
 		u16 timeMid = u16((tv >> 32) & 0xFFFF);
 		u16 timeHiAndVersion = u16((tv >> 48) & 0x0FFF) + (uuid_t::UUID_TIME_BASED << 12);
-		u16 clockSeq = (u16(_random.generate() >> 4) & 0x3FFF) | 0x8000;
+		u16 clockSeq = (_clockSeq & 0x3FFF) | 0x8000;
 		return uuid_t(timeLow, timeMid, timeHiAndVersion, clockSeq, _mac);
 	}
 
@@ -94,26 +263,68 @@ namespace ncore
 		return xuuid_(buffer, uuid_t::UUID_RANDOM);
 	}
 
+	void uuid_generator::create(uuid_t* ids, s32 count)
+	{
+		for (s32 i = 0; i < count; ++i)
+			ids[i] = create();
+	}
+
+	void uuid_generator::createRandom(uuid_t* ids, s32 count)
+	{
+		init();
+
+		u8 buffer[16 * 16];
+		while (count > 0)
+		{
+			s32 const n = count < 16 ? count : 16;
+			nrnd::randBuffer(buffer, 16 * n);
+			for (s32 i = 0; i < n; ++i)
+				ids[i] = xuuid_(&buffer[i * 16], uuid_t::UUID_RANDOM);
+			ids += n;
+			count -= n;
+		}
+	}
+
 
 	void uuid_generator::timeStamp(datetime_t& dt)
 	{
+		// Last timestamp handed out, the clock reading plus the ticks we counted on from it
+		u64 const issued = u64(_lastTime.toBinary()) + _ticks;
+
 		datetime_t now = datetime_t::sNow();
 		for (;;)
 		{
-			if (now != _lastTime)
+			u64 const tv = now.toBinary();
+			if (tv < u64(_lastTime.toBinary()))
+			{
+				// The clock went backwards, change the clock sequence (RFC 4122 4.2.1)
+				_clockSeq = (_clockSeq + 1) & 0x3FFF;
+				if (_state != nullptr)
+					_state->m_clockSeq = _clockSeq;
+				_lastTime = now;
+				_ticks = 0;
+				break;
+			}
+			if (tv > issued)
 			{
 				_lastTime = now;
 				_ticks = 0;
 				break;
 			}
-			if (_ticks < 100)
+			// The clock has not passed the last timestamp yet, count on from it
+			// but never run more than 100 ticks ahead of the clock.
+			s32 const ticks = s32(issued + 1 - tv);
+			if (ticks <= 100)
 			{
-				++_ticks;
+				_lastTime = now;
+				_ticks = ticks;
 				break;
 			}
 			now = datetime_t::sNow();
 		}
-		u64 tv = datetime_t::sNow().toBinary() + _ticks;
+		u64 tv = now.toBinary() + _ticks;
+		if (_state != nullptr)
+			_state->m_lastTime = tv;
 		dt = datetime_t(tv);
 	}
 
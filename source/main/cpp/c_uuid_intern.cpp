@@ -0,0 +1,186 @@
+#include "ccore/c_debug.h"
+#include "cbase/c_allocator.h"
+#include "cuuid/c_uuid_intern.h"
+
+#include <new>
+
+namespace ncore
+{
+    // The string comes first, so that toUuid() can find the uuid_t behind it
+    struct uuid_intern_entry_t
+    {
+        char   m_str[40];
+        uuid_t m_id;
+    };
+
+    struct uuid_intern_chunk_t
+    {
+        uuid_intern_chunk_t* m_next;
+        u64                  m_padding;
+    };
+
+    uuid_intern_table::uuid_intern_table()
+        : _allocator(nullptr)
+        , _slots(nullptr)
+        , _capacity(0)
+        , _shift(64)
+        , _chunkSize(0)
+        , _size(0)
+        , _epoch(0)
+        , _cursor(nullptr)
+        , _end(nullptr)
+    {
+        _chunks[0] = nullptr;
+        _chunks[1] = nullptr;
+    }
+
+    uuid_intern_table::~uuid_intern_table() { release(); }
+
+    bool uuid_intern_table::init(alloc_t* allocator, u32 capacity, u32 chunkSize)
+    {
+        release();
+
+        // Keep the load factor at or below 50%
+        u32 bits = 4;
+        while (((u32)1 << bits) < capacity * 2)
+            bits++;
+        u32 const numSlots = (u32)1 << bits;
+
+        _slots = (std::atomic<uuid_intern_entry_t*>*)allocator->allocate(numSlots * sizeof(std::atomic<uuid_intern_entry_t*>), 64);
+        if (_slots == nullptr)
+            return false;
+        for (u32 i = 0; i < numSlots; ++i)
+            new (&_slots[i]) std::atomic<uuid_intern_entry_t*>(nullptr);
+
+        _allocator = allocator;
+        _capacity  = capacity;
+        _shift     = 64 - bits;
+        _chunkSize = chunkSize < 1024 ? 1024 : chunkSize;
+        _size.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void uuid_intern_table::release()
+    {
+        if (_slots != nullptr)
+        {
+            _allocator->deallocate(_slots);
+            _slots = nullptr;
+        }
+        freeChunks(_chunks[0]);
+        freeChunks(_chunks[1]);
+        _chunks[0] = nullptr;
+        _chunks[1] = nullptr;
+        _cursor    = nullptr;
+        _end       = nullptr;
+        _capacity  = 0;
+        _shift     = 64;
+        _size.store(0, std::memory_order_relaxed);
+    }
+
+    const char* uuid_intern_table::find(const uuid_t& id) const
+    {
+        if (_slots == nullptr)
+            return nullptr;
+
+        u32 const mask = ((u32)1 << (64 - _shift)) - 1;
+        for (u32 i = (u32)(id.hash() >> _shift);; i = (i + 1) & mask)
+        {
+            uuid_intern_entry_t const* entry = _slots[i].load(std::memory_order_acquire);
+            if (entry == nullptr)
+                return nullptr;
+            if (entry->m_id == id)
+                return entry->m_str;
+        }
+    }
+
+    const char* uuid_intern_table::intern(const uuid_t& id)
+    {
+        const char* str = find(id);
+        if (str != nullptr || _slots == nullptr)
+            return str;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Another thread may have interned it while we were waiting
+        u32 const mask = ((u32)1 << (64 - _shift)) - 1;
+        u32       i    = (u32)(id.hash() >> _shift);
+        for (;; i = (i + 1) & mask)
+        {
+            uuid_intern_entry_t const* entry = _slots[i].load(std::memory_order_relaxed);
+            if (entry == nullptr)
+                break;
+            if (entry->m_id == id)
+                return entry->m_str;
+        }
+
+        // A full table interns nothing more until the next epoch
+        if (_size.load(std::memory_order_relaxed) >= _capacity)
+            return nullptr;
+
+        uuid_intern_entry_t* entry = allocate();
+        if (entry == nullptr)
+            return nullptr;
+        new (&entry->m_id) uuid_t(id);
+        id.toChars(entry->m_str);
+        entry->m_str[36] = 0;
+
+        _slots[i].store(entry, std::memory_order_release);
+        _size.fetch_add(1, std::memory_order_relaxed);
+        return entry->m_str;
+    }
+
+    uuid_t uuid_intern_table::toUuid(const char* str)
+    {
+        uuid_intern_entry_t const* entry = (uuid_intern_entry_t const*)str;
+        return entry->m_id;
+    }
+
+    void uuid_intern_table::newEpoch()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        u32 const numSlots = _slots != nullptr ? ((u32)1 << (64 - _shift)) : 0;
+        for (u32 i = 0; i < numSlots; ++i)
+            _slots[i].store(nullptr, std::memory_order_release);
+        _size.store(0, std::memory_order_relaxed);
+
+        // The strings of the previous epoch stay alive, the ones before are freed
+        _epoch++;
+        freeChunks(_chunks[_epoch & 1]);
+        _chunks[_epoch & 1] = nullptr;
+        _cursor             = nullptr;
+        _end                = nullptr;
+    }
+
+    u32 uuid_intern_table::size() const { return _size.load(std::memory_order_relaxed); }
+
+    uuid_intern_entry_t* uuid_intern_table::allocate()
+    {
+        if (_cursor == nullptr || (_cursor + sizeof(uuid_intern_entry_t)) > _end)
+        {
+            uuid_intern_chunk_t* chunk = (uuid_intern_chunk_t*)_allocator->allocate(_chunkSize, 16);
+            if (chunk == nullptr)
+                return nullptr;
+            chunk->m_next       = _chunks[_epoch & 1];
+            _chunks[_epoch & 1] = chunk;
+            _cursor             = (u8*)chunk + sizeof(uuid_intern_chunk_t);
+            _end                = (u8*)chunk + _chunkSize;
+        }
+
+        uuid_intern_entry_t* entry = (uuid_intern_entry_t*)_cursor;
+        _cursor += sizeof(uuid_intern_entry_t);
+        return entry;
+    }
+
+    void uuid_intern_table::freeChunks(uuid_intern_chunk_t* chunk)
+    {
+        while (chunk != nullptr)
+        {
+            uuid_intern_chunk_t* next = chunk->m_next;
+            _allocator->deallocate(chunk);
+            chunk = next;
+        }
+    }
+
+}  // namespace ncore
@@ -0,0 +1,83 @@
+#include "ccore/c_debug.h"
+#include "cuuid/c_uuid_pool.h"
+
+namespace ncore
+{
+    // Per-thread block of sequence numbers, reserved from one pool
+    struct uuid_pool_cursor_t
+    {
+        u64 m_pool;
+        u64 m_upper;
+        u64 m_next;
+        u64 m_end;
+    };
+
+    namespace npool
+    {
+        static const u64 cBlockSize    = 1024;
+        static const u64 cSequenceMask = 0x3FFFFFFFFFFFFFFFull;
+        static const u64 cVariantBits  = 0x8000000000000000ull;
+
+        static std::atomic<u64>               sPoolIds(1);
+        static thread_local uuid_pool_cursor_t sCursor = {0, 0, 0, 0};
+    }  // namespace npool
+
+    uuid_pool::uuid_pool(uuid_t::Version version, u64 reseedInterval)
+        : _upper(0)
+        , _counter(0)
+        , _reseeding(0)
+        , _lower(0)
+        , _versionBits((u64)version << 12)
+        , _reseedInterval(reseedInterval < npool::cBlockSize ? npool::cBlockSize : reseedInterval)
+        , _id(npool::sPoolIds.fetch_add(1, std::memory_order_relaxed))
+    {
+        ASSERT(version == uuid_t::UUID_RANDOM || version == uuid_t::UUID_CUSTOM);
+
+        uuid_t const base = _generator.createRandom();
+        _lower            = base.lower();
+        _upper.store((base.upper() & ~(u64)0xF000) | _versionBits, std::memory_order_release);
+    }
+
+    uuid_pool::~uuid_pool() {}
+
+    uuid_t uuid_pool::allocate()
+    {
+        uuid_pool_cursor_t& cursor = npool::sCursor;
+        if (cursor.m_pool != _id || cursor.m_next == cursor.m_end)
+            refill(cursor);
+
+        u64 const sequence = cursor.m_next++;
+        return uuid_t(cursor.m_upper, ((_lower + sequence) & npool::cSequenceMask) | npool::cVariantBits);
+    }
+
+    void uuid_pool::reseed()
+    {
+        // Only one thread reseeds at a time, the others keep using the
+        // current upper bits instead of waiting.
+        if (_reseeding.exchange(1, std::memory_order_acquire) != 0)
+            return;
+
+        u64 const upper = _generator.createRandom().upper();
+        _upper.store((upper & ~(u64)0xF000) | _versionBits, std::memory_order_release);
+        _reseeding.store(0, std::memory_order_release);
+    }
+
+    void uuid_pool::refill(uuid_pool_cursor_t& cursor)
+    {
+        u64 const start = _counter.fetch_add(npool::cBlockSize, std::memory_order_relaxed);
+        ASSERT(start < npool::cSequenceMask);
+
+        // Reseed when this block holds a multiple of the interval, the
+        // first block keeps the seed of the constructor. Uniqueness comes
+        // from the sequence number alone, so a reseed that races with other
+        // threads reserving blocks is harmless.
+        if (start > 0 && ((start - 1) / _reseedInterval) != ((start + npool::cBlockSize - 1) / _reseedInterval))
+            reseed();
+
+        cursor.m_pool  = _id;
+        cursor.m_upper = _upper.load(std::memory_order_acquire);
+        cursor.m_next  = start;
+        cursor.m_end   = start + npool::cBlockSize;
+    }
+
+}  // namespace ncore
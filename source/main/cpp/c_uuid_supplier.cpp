@@ -0,0 +1,243 @@
+#include "ccore/c_debug.h"
+#include "cbase/c_allocator.h"
+#include "cuuid/c_uuid_supplier.h"
+
+#include <new>
+
+namespace ncore
+{
+    // Ring buffer cell, the sequence number tells producers and consumers
+    // whose turn it is (bounded MPMC queue by Dmitry Vyukov).
+    struct uuid_supplier_cell_t
+    {
+        std::atomic<u64> m_sequence;
+        uuid_t           m_id;
+    };
+
+    namespace nsupplier
+    {
+        static const s32 cBatchSize = 64;
+    }
+
+    uuid_supplier::uuid_supplier()
+        : _allocator(nullptr)
+        , _cells(nullptr)
+        , _mask(0)
+        , _lowWatermark(0)
+        , _highWatermark(0)
+        , _version(uuid_t::UUID_RANDOM)
+        , _enqueuePos(0)
+        , _dequeuePos(0)
+        , _refillRequested(0)
+        , _running(false)
+    {
+    }
+
+    uuid_supplier::~uuid_supplier() { stop(); }
+
+    bool uuid_supplier::start(alloc_t* allocator, uuid_t::Version version, u32 capacity, u32 lowWatermark, u32 highWatermark)
+    {
+        ASSERT(version == uuid_t::UUID_TIME_BASED || version == uuid_t::UUID_RANDOM);
+        stop();
+
+        u32 size = 16;
+        while (size < capacity)
+            size <<= 1;
+
+        _cells = (uuid_supplier_cell_t*)allocator->allocate(size * sizeof(uuid_supplier_cell_t), 64);
+        if (_cells == nullptr)
+            return false;
+        for (u32 i = 0; i < size; ++i)
+            new (&_cells[i]) uuid_supplier_cell_t();
+        for (u32 i = 0; i < size; ++i)
+            _cells[i].m_sequence.store(i, std::memory_order_relaxed);
+
+        _allocator     = allocator;
+        _mask          = size - 1;
+        _highWatermark = highWatermark > size ? size : highWatermark;
+        _lowWatermark  = lowWatermark >= _highWatermark ? _highWatermark / 2 : lowWatermark;
+        _version       = version;
+        _enqueuePos.store(0, std::memory_order_relaxed);
+        _dequeuePos.store(0, std::memory_order_relaxed);
+        _refillRequested.store(0, std::memory_order_relaxed);
+
+        fill();
+
+        _running = true;
+        _thread  = std::thread(&uuid_supplier::run, this);
+        return true;
+    }
+
+    void uuid_supplier::stop()
+    {
+        if (_running)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_wakeMutex);
+                _running = false;
+            }
+            _wake.notify_one();
+            _thread.join();
+        }
+
+        if (_cells != nullptr)
+        {
+            for (u32 i = 0; i <= _mask; ++i)
+                _cells[i].~uuid_supplier_cell_t();
+            _allocator->deallocate(_cells);
+            _cells = nullptr;
+            _mask  = 0;
+        }
+    }
+
+    uuid_t uuid_supplier::take()
+    {
+        uuid_t id;
+        bool const popped = pop(id);
+
+        if (available() <= _lowWatermark && _refillRequested.exchange(1, std::memory_order_acq_rel) == 0)
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wake.notify_one();
+        }
+
+        if (!popped)
+            id = fallback();
+        return id;
+    }
+
+    u32 uuid_supplier::available() const
+    {
+        u64 const dequeuePos = _dequeuePos.load(std::memory_order_relaxed);
+        u64 const enqueuePos = _enqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? (u32)(enqueuePos - dequeuePos) : 0;
+    }
+
+    bool uuid_supplier::push(const uuid_t& id)
+    {
+        u64 pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            uuid_supplier_cell_t* cell     = &_cells[pos & _mask];
+            u64 const             sequence = cell->m_sequence.load(std::memory_order_acquire);
+            s64 const             diff     = (s64)sequence - (s64)pos;
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell->m_id = id;
+                    cell->m_sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;  // full
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool uuid_supplier::pop(uuid_t& id)
+    {
+        if (_cells == nullptr)
+            return false;
+
+        u64 pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            uuid_supplier_cell_t* cell     = &_cells[pos & _mask];
+            u64 const             sequence = cell->m_sequence.load(std::memory_order_acquire);
+            s64 const             diff     = (s64)sequence - (s64)(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    id = cell->m_id;
+                    cell->m_sequence.store(pos + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;  // empty
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only the filling thread generates batches. Time-based uuid_t's share the
+    // generator with the fallback to stay on one clock sequence, so they are
+    // generated one per lock and a waiting consumer never waits for a batch.
+    void uuid_supplier::generate(uuid_t* ids, s32 count)
+    {
+        if (_version == uuid_t::UUID_TIME_BASED)
+        {
+            for (s32 i = 0; i < count; ++i)
+            {
+                std::lock_guard<std::mutex> lock(_generatorMutex);
+                ids[i] = _generator.create();
+            }
+        }
+        else
+        {
+            _generator.createRandom(ids, count);
+        }
+    }
+
+    uuid_t uuid_supplier::fallback()
+    {
+        if (_version == uuid_t::UUID_TIME_BASED)
+        {
+            std::lock_guard<std::mutex> lock(_generatorMutex);
+            return _generator.create();
+        }
+        std::lock_guard<std::mutex> lock(_fallbackMutex);
+        return _fallbackGenerator.createRandom();
+    }
+
+    void uuid_supplier::fill()
+    {
+        uuid_t batch[nsupplier::cBatchSize];
+        for (;;)
+        {
+            u32 const count = available();
+            if (count >= _highWatermark)
+                break;
+
+            s32 const n = (_highWatermark - count) < (u32)nsupplier::cBatchSize ? (s32)(_highWatermark - count) : nsupplier::cBatchSize;
+            generate(batch, n);
+            for (s32 i = 0; i < n; ++i)
+            {
+                if (!push(batch[i]))
+                    return;
+            }
+        }
+    }
+
+    void uuid_supplier::run()
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_wakeMutex);
+                while (_running && _refillRequested.load(std::memory_order_acquire) == 0)
+                    _wake.wait(lock);
+                if (!_running)
+                    return;
+            }
+
+            // Clear the request before filling, a consumer that drains the ring
+            // while we fill raises it again and we go around once more.
+            _refillRequested.store(0, std::memory_order_release);
+            fill();
+        }
+    }
+
+}  // namespace ncore
@@ -54,7 +54,8 @@ namespace ncore
             UUID_TIME_BASED = 0x01,
             UUID_DCE_UID    = 0x02,
             UUID_NAME_BASED = 0x03,
-            UUID_RANDOM     = 0x04
+            UUID_RANDOM     = 0x04,
+            UUID_CUSTOM     = 0x08
         };
 
         uuid_t();
@@ -64,7 +65,7 @@ namespace ncore
         /// Copy constructor.
 
         explicit uuid_t(const char* uuid);
-        /// Parses the uuid_t from a string.
+        /// Parses the uuid_t from a string, an invalid string gives the nil uuid_t.
 
         ~uuid_t();
         /// Destroys the uuid_t.
@@ -85,6 +86,10 @@ namespace ncore
         /// Returns a string representation of the uuid_t consisting
         /// of groups of hexadecimal digits separated by hyphens.
 
+        void toChars(char* str) const;
+        /// Writes the same representation as toString() as 36
+        /// characters to str, without a terminating zero.
+
         void copyFrom(const u8* buffer);
         /// Copies the uuid_t (16 bytes) from a buffer or byte array.
         /// The uuid_t fields are expected to be
@@ -107,6 +112,20 @@ namespace ncore
         ///   - 6 reserved, Microsoft Corporation backward compatibility
         ///   - 7 reserved for future definition
 
+        u64 upper() const;
+        /// Returns the most significant 64 bits of the uuid_t
+        /// (time_low, time_mid, time_hi_and_version) as an integer.
+
+        u64 lower() const;
+        /// Returns the least significant 64 bits of the uuid_t
+        /// (clock_seq and node) as an integer.
+
+        u64 hash() const;
+        /// Folds the 128 bits into a 64-bit hash for hash tables and filters.
+        /// Random (v4) UUIDs are already uniform, the xor-shift and multiply
+        /// make the changing timestamp bits of time-based (v1) UUIDs reach
+        /// every bit.
+
         bool operator==(const uuid_t& uuid) const;
         bool operator!=(const uuid_t& uuid) const;
         bool operator<(const uuid_t& uuid) const;
@@ -136,6 +155,7 @@ namespace ncore
     protected:
         uuid_t(u32 timeLow, u32 timeMid, u32 timeHiAndVersion, u16 clockSeq, mac_t mac);
         uuid_t(const u8* bytes, Version version);
+        uuid_t(u64 upper, u64 lower);
 
         s32 compare(const uuid_t& uuid) const;
 
@@ -156,6 +176,7 @@ namespace ncore
         mac_t _mac;
 
         friend class uuid_generator;
+        friend class uuid_pool;
     };
 
     //
@@ -168,6 +189,26 @@ namespace ncore
     inline bool uuid_t::operator>(const uuid_t& uuid) const { return compare(uuid) > 0; }
     inline bool uuid_t::operator>=(const uuid_t& uuid) const { return compare(uuid) >= 0; }
     inline uuid_t::Version uuid_t::version() const { return Version(_timeHiAndVersion >> 12); }
+    inline uuid_t::uuid_t(u64 upper, u64 lower)
+        : _timeLow(u32(upper >> 32))
+        , _timeMid(u16(upper >> 16))
+        , _timeHiAndVersion(u16(upper))
+        , _clockSeq(u16(lower >> 48))
+    {
+        for (s32 i = 0; i < 6; ++i)
+            _mac.m_data[i] = u8(lower >> (40 - (i * 8)));
+    }
+    inline u64 uuid_t::upper() const { return ((u64)_timeLow << 32) | ((u64)_timeMid << 16) | (u64)_timeHiAndVersion; }
+    inline u64 uuid_t::lower() const
+    {
+        return ((u64)_clockSeq << 48) | ((u64)_mac.m_data[0] << 40) | ((u64)_mac.m_data[1] << 32) | ((u64)_mac.m_data[2] << 24) | ((u64)_mac.m_data[3] << 16) | ((u64)_mac.m_data[4] << 8) | (u64)_mac.m_data[5];
+    }
+    inline u64 uuid_t::hash() const
+    {
+        u64 h = upper() ^ lower();
+        h ^= h >> 32;
+        return h * 0x9E3779B97F4A7C15ull;
+    }
     inline bool uuid_t::isNull() const { return compare(null()) == 0; }
     inline void swap(uuid_t& u1, uuid_t& u2) { u1.swap(u2); }
 
@@ -0,0 +1,133 @@
+#ifndef __CUUID_UUID_FILTER_H__
+#define __CUUID_UUID_FILTER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "cuuid/c_uuid.h"
+
+namespace ncore
+{
+    class alloc_t;
+
+    // A cache-line blocked Bloom filter over a set of uuid_t.
+    // Every uuid_t maps to exactly one 64-byte block and sets one bit in
+    // each of the 8 words of that block, so a query touches a single cache
+    // line. Probe positions are taken straight from the uuid_t words (with
+    // one multiply to spread time-based UUIDs), no generic hash is run over
+    // the 16 bytes.
+    //
+    // The serialized form is a 64-byte header followed by the blocks, so a
+    // file written with serialize() can be memory-mapped and handed to
+    // attach() without copying.
+    class uuid_bloom_filter
+    {
+    public:
+        uuid_bloom_filter();
+        ~uuid_bloom_filter();
+
+        bool init(alloc_t* allocator, u64 expectedCount, u32 bitsPerItem = 10);
+        // Allocates and clears a filter sized for the expected number of
+        // uuid_t's. Around 10 bits per item gives a false positive rate of ~1%.
+
+        void release();
+        // Releases the owned blocks, or detaches from attached memory.
+
+        void clear();
+        // Resets all bits, the filter must own its blocks.
+
+        void insert(const uuid_t& id);
+        // Adds the uuid_t to the set, the filter must own its blocks.
+
+        bool contains(const uuid_t& id) const;
+        // Returns false if the uuid_t is definitely not in the set.
+
+        void containsBatch(const uuid_t* ids, s32 count, bool* results) const;
+        // Queries many uuid_t's at once, prefetching the blocks of upcoming
+        // queries to hide memory latency.
+
+        u64 serializedSize() const;
+        // Number of bytes serialize() will write.
+
+        void serialize(u8* buffer) const;
+        // Writes the header and blocks to the buffer, which must be at least
+        // serializedSize() bytes.
+
+        bool attach(const u8* buffer, u64 size);
+        // Uses serialized data (e.g. a memory-mapped file) in place, the
+        // buffer must be 64-byte aligned and outlive the filter.
+        // Returns false if the data is not a valid serialized filter.
+
+    private:
+        alloc_t* _allocator;
+        u64*     _blocks;
+        u64      _numBlocks;
+        bool     _owned;
+
+        uuid_bloom_filter(const uuid_bloom_filter&);
+        uuid_bloom_filter& operator=(const uuid_bloom_filter&) { return *this; }
+    };
+
+    // A static binary fuse filter (the successor of the xor filter) with 8-bit
+    // fingerprints over a set of uuid_t. It is built once from the complete
+    // set, uses ~9 bits per entry for a ~0.4% false positive rate and answers
+    // a query with 3 memory accesses.
+    //
+    // Like uuid_bloom_filter the serialized form is a 64-byte header followed
+    // by the fingerprints and can be used in place through attach().
+    class uuid_fuse_filter
+    {
+    public:
+        uuid_fuse_filter();
+        ~uuid_fuse_filter();
+
+        bool build(alloc_t* allocator, const uuid_t* ids, u32 count);
+        // Builds the filter from the set of uuid_t's, duplicates are allowed.
+        // Returns false if construction fails, which is very unlikely, if the
+        // scratch memory cannot be allocated, or if count exceeds ~470 million
+        // keys (shard larger sets by the upper bits of the uuid_t).
+
+        void release();
+        // Releases the owned fingerprints, or detaches from attached memory.
+
+        bool contains(const uuid_t& id) const;
+        // Returns false if the uuid_t is definitely not in the set.
+
+        void containsBatch(const uuid_t* ids, s32 count, bool* results) const;
+        // Queries many uuid_t's at once, prefetching the fingerprints of
+        // upcoming queries to hide memory latency.
+
+        u64 serializedSize() const;
+        // Number of bytes serialize() will write.
+
+        void serialize(u8* buffer) const;
+        // Writes the header and fingerprints to the buffer, which must be at
+        // least serializedSize() bytes.
+
+        bool attach(const u8* buffer, u64 size);
+        // Uses serialized data (e.g. a memory-mapped file) in place, the
+        // buffer must outlive the filter.
+        // Returns false if the data is not a valid serialized filter.
+
+    private:
+        void layout(u32 count);
+        void positions(u64 hash, u32& h0, u32& h1, u32& h2) const;
+
+        alloc_t* _allocator;
+        u8*      _fingerprints;
+        u64      _seed;
+        u32      _segmentLength;
+        u32      _segmentLengthMask;
+        u32      _segmentCount;
+        u32      _segmentCountLength;
+        u32      _arrayLength;
+        bool     _owned;
+
+        uuid_fuse_filter(const uuid_fuse_filter&);
+        uuid_fuse_filter& operator=(const uuid_fuse_filter&) { return *this; }
+    };
+
+}  // namespace ncore
+
+#endif  // __CUUID_UUID_FILTER_H__
@@ -20,6 +20,13 @@ namespace ncore
     // RFC 2518 (WebDAV), section 6.4.1 and the UUIDs and GUIDs internet
     // draft by Leach/Salz from February, 1998
     // (http://ftp.ics.uci.edu/pub/ietf/webdav/uuid-guid/draft-leach-uuids-guids-01.txt)
+    //
+    // The generator detects that the process was forked (or that the
+    // application reported a VM snapshot restore) through a cheap generation
+    // check and then reseeds its random state and clock sequence, so parent
+    // and child never produce the same time-based uuid_t.
+    struct uuid_state_t;
+
     class uuid_generator
     {
     public:
@@ -42,6 +49,13 @@ namespace ncore
         uuid_t createRandom();
         // Creates a random uuid_t.
 
+        void create(uuid_t* ids, s32 count);
+        // Creates 'count' time-based uuid_t's, see create().
+
+        void createRandom(uuid_t* ids, s32 count);
+        // Creates 'count' random uuid_t's, reading the random bytes for many
+        // of them at once.
+
         uuid_t createOne();
         // Tries to create and return a time-based uuid_t (see create()), and,
         // if that does not work due to the unavailability of a MAC address,
@@ -50,17 +64,36 @@ namespace ncore
         // The uuid_t::version() method can be used to determine the actual kind of
         // the uuid_t generated.
 
+        bool attachStateFile(const char* path);
+        // Memory-maps a small state file (creating it if needed) that holds the
+        // last timestamp and clock sequence, as described in RFC 4122 4.2.1.
+        // The clock sequence is restored from it and advanced when the clock
+        // went backwards since the last run. Only one process should use a
+        // state file at a time (forked children are fine, they reseed).
+        // Returns false if the file cannot be mapped.
+
+        void detachStateFile();
+        // Unmaps the state file, if any.
+
+        static void notifySnapshotRestored();
+        // Call after the process was restored from a VM snapshot; every
+        // uuid_generator reseeds before it creates its next uuid_t.
+
     protected:
         void init();
+        void reseed();
         void timeStamp(datetime_t& dt);
 
     private:
-        bool         _initialized;
-        bool         _haveMac;
-        nrnd::good_t _random;
-        datetime_t   _lastTime;
-        s32          _ticks;
-        mac_t        _mac;
+        bool          _initialized;
+        bool          _haveMac;
+        nrnd::good_t  _random;
+        datetime_t    _lastTime;
+        s32           _ticks;
+        u32           _generation;
+        u16           _clockSeq;
+        mac_t         _mac;
+        uuid_state_t* _state;
 
         uuid_generator(const uuid_generator&);
         uuid_generator& operator=(const uuid_generator&) { return *this; }
@@ -0,0 +1,83 @@
+#ifndef __CUUID_UUID_INTERN_H__
+#define __CUUID_UUID_INTERN_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "cuuid/c_uuid.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace ncore
+{
+    class alloc_t;
+    struct uuid_intern_entry_t;
+    struct uuid_intern_chunk_t;
+
+    // Interns the text of uuid_t's, so that a uuid_t that is converted to
+    // text many times (logs, headers, keys) is formatted only once and then
+    // shared by pointer.
+    //
+    // The strings are the 36 characters of uuid_t::toString() plus a
+    // terminating zero, bump-allocated from arena chunks. Lookups are
+    // lock-free, interning a new uuid_t takes a lock.
+    //
+    // Memory is released in bulk per epoch: newEpoch() empties the table and
+    // frees the strings of the epoch before the previous one, so strings
+    // handed out stay valid until the second newEpoch() call after them.
+    class uuid_intern_table
+    {
+    public:
+        uuid_intern_table();
+        ~uuid_intern_table();
+
+        bool init(alloc_t* allocator, u32 capacity, u32 chunkSize = 64 * 1024);
+        // Creates a table that interns up to 'capacity' strings per epoch.
+
+        void release();
+        // Frees the table and all strings.
+
+        const char* intern(const uuid_t& id);
+        // Returns the interned string of the uuid_t, formatting it on first use.
+        // Returns nullptr when the table is full (or out of memory), uuid_t's
+        // that are already interned are still found. Use uuid_t::toChars()
+        // into a buffer of your own in that case.
+
+        const char* find(const uuid_t& id) const;
+        // Returns the interned string of the uuid_t, or nullptr.
+
+        static uuid_t toUuid(const char* str);
+        // Returns the uuid_t of a string returned by intern() or find().
+
+        void newEpoch();
+        // Starts a new epoch, see above.
+
+        u32 size() const;
+        // Number of uuid_t's indexed in the current epoch.
+
+    protected:
+        uuid_intern_entry_t* allocate();
+        void                 freeChunks(uuid_intern_chunk_t* chunk);
+
+    private:
+        alloc_t*                           _allocator;
+        std::atomic<uuid_intern_entry_t*>* _slots;
+        u32                                _capacity;
+        u32                                _shift;
+        u32                                _chunkSize;
+        std::atomic<u32>                   _size;
+        uuid_intern_chunk_t*               _chunks[2];
+        u32                                _epoch;
+        u8*                                _cursor;
+        u8*                                _end;
+        std::mutex                         _mutex;
+
+        uuid_intern_table(const uuid_intern_table&);
+        uuid_intern_table& operator=(const uuid_intern_table&) { return *this; }
+    };
+
+}  // namespace ncore
+
+#endif  // __CUUID_UUID_INTERN_H__
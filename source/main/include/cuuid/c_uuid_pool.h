@@ -0,0 +1,66 @@
+#ifndef __CUUID_UUID_POOL_H__
+#define __CUUID_UUID_POOL_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_generator.h"
+
+#include <atomic>
+
+namespace ncore
+{
+    struct uuid_pool_cursor_t;
+
+    // A pool of process-local sequential uuid_t's.
+    //
+    // The pool seeds a random 128-bit base once through
+    // uuid_generator::createRandom(). Each thread reserves a block of
+    // sequence numbers with a single fetch-add on the shared counter and
+    // then allocates from that block with a plain increment, so allocation
+    // is wait-free and costs about as much as a counter increment. Each
+    // thread caches a block of one pool only, alternating between pools on
+    // the same thread reserves a new block on every switch.
+    //
+    // The sequence number is added to the low 62 bits of the base, which
+    // makes the uuid_t's unique within the process, but predictable. Do not
+    // use them where an outsider must not be able to guess the next ID.
+    // The upper 64 bits are reseeded every 'reseedInterval' allocations.
+    class uuid_pool
+    {
+    public:
+        uuid_pool(uuid_t::Version version = uuid_t::UUID_RANDOM, u64 reseedInterval = (u64)1 << 32);
+        // Creates the pool, the version must be UUID_RANDOM (v4) or
+        // UUID_CUSTOM (v8).
+
+        ~uuid_pool();
+        // Destroys the uuid_pool.
+
+        uuid_t allocate();
+        // Returns a new uuid_t, unique for the lifetime of the pool.
+
+        void reseed();
+        // Replaces the random upper 64 bits of the base.
+
+    protected:
+        void refill(uuid_pool_cursor_t& cursor);
+
+    private:
+        uuid_generator   _generator;
+        std::atomic<u64> _upper;
+        std::atomic<u64> _counter;
+        std::atomic<u32> _reseeding;
+        u64              _lower;
+        u64              _versionBits;
+        u64              _reseedInterval;
+        u64              _id;
+
+        uuid_pool(const uuid_pool&);
+        uuid_pool& operator=(const uuid_pool&) { return *this; }
+    };
+
+}  // namespace ncore
+
+#endif  // __CUUID_UUID_POOL_H__
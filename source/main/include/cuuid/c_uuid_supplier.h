@@ -0,0 +1,90 @@
+#ifndef __CUUID_UUID_SUPPLIER_H__
+#define __CUUID_UUID_SUPPLIER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_generator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ncore
+{
+    class alloc_t;
+    struct uuid_supplier_cell_t;
+
+    // Hands out pre-generated uuid_t's from a lock-free ring buffer that a
+    // background thread keeps topped up.
+    //
+    // Consumers (any number of threads) only pop from the ring. When the ring
+    // drops to the low watermark the background thread is woken and refills
+    // it up to the high watermark using the bulk generation paths of
+    // uuid_generator. When the ring is empty take() falls back to generating
+    // a single uuid_t synchronously. Random uuid_t's come from a separate
+    // generator then; time-based uuid_t's must stay on one clock sequence, so
+    // the background thread generates those one at a time under a lock that
+    // the fallback waits on for at most one uuid_t.
+    class uuid_supplier
+    {
+    public:
+        uuid_supplier();
+        ~uuid_supplier();
+
+        bool start(alloc_t* allocator, uuid_t::Version version, u32 capacity = 4096, u32 lowWatermark = 1024, u32 highWatermark = 4096);
+        // Allocates the ring, fills it and starts the background thread.
+        // The version must be UUID_TIME_BASED (v1) or UUID_RANDOM (v4), the
+        // capacity is rounded up to a power of two.
+
+        void stop();
+        // Stops the background thread and releases the ring.
+
+        uuid_t take();
+        // Returns the next uuid_t, from the ring when possible.
+
+        u32 available() const;
+        // Approximate number of uuid_t's in the ring.
+
+    protected:
+        bool push(const uuid_t& id);
+        bool pop(uuid_t& id);
+        void generate(uuid_t* ids, s32 count);
+        uuid_t fallback();
+        void fill();
+        void run();
+
+    private:
+        alloc_t*              _allocator;
+        uuid_supplier_cell_t* _cells;
+        u32                   _mask;
+        u32                   _lowWatermark;
+        u32                   _highWatermark;
+        uuid_t::Version       _version;
+
+        // Producers and consumers each own a cache line
+        std::atomic<u64> _enqueuePos;
+        u8               _enqueuePad[64 - sizeof(std::atomic<u64>)];
+        std::atomic<u64> _dequeuePos;
+        u8               _dequeuePad[64 - sizeof(std::atomic<u64>)];
+        std::atomic<u32> _refillRequested;
+        bool             _running;
+
+        uuid_generator          _generator;
+        std::mutex              _generatorMutex;
+        uuid_generator          _fallbackGenerator;
+        std::mutex              _fallbackMutex;
+        std::mutex              _wakeMutex;
+        std::condition_variable _wake;
+        std::thread             _thread;
+
+        uuid_supplier(const uuid_supplier&);
+        uuid_supplier& operator=(const uuid_supplier&) { return *this; }
+    };
+
+}  // namespace ncore
+
+#endif  // __CUUID_UUID_SUPPLIER_H__
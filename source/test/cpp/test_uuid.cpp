@@ -1,6 +1,16 @@
+#include "cbase/c_allocator.h"
+#include "cbase/c_context.h"
 #include "cuuid/c_uuid.h"
 #include "cuuid/c_uuid_generator.h"
 #include "cunittest/cunittest.h"
+#include "test_uuid_unique.h"
+
+#include <stdio.h>
+
+#if defined(TARGET_LINUX)
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
 
 using namespace ncore;
 
@@ -23,12 +33,147 @@ UNITTEST_SUITE_BEGIN(uuid)
 			CHECK_FALSE(id.isNull());
 		}
 
+		UNITTEST_TEST(to_chars)
+		{
+			uuid_t id("A0B1C2D3-AACC-88EE-FF44-5566AADD2200");
+			char   str[37];
+			id.toChars(str);
+			str[36] = 0;
+
+			uuid_t parsed;
+			CHECK_TRUE(parsed.tryParse(str));
+			CHECK_TRUE(parsed == id);
+		}
+
+		UNITTEST_TEST(to_bytes)
+		{
+			uuid_t id("A0B1C2D3-AACC-88EE-FF44-5566AADD2200");
+			u8     bytes[16];
+			id.copyTo(bytes);
+			CHECK_EQUAL(0xA0, bytes[0]);
+			CHECK_EQUAL(0xD3, bytes[3]);
+			CHECK_EQUAL(0x88, bytes[6]);
+			CHECK_EQUAL(0x44, bytes[9]);
+			CHECK_EQUAL(0x55, bytes[10]);
+			CHECK_EQUAL(0x00, bytes[15]);
+
+			uuid_t copy;
+			copy.copyFrom(bytes);
+			CHECK_TRUE(copy == id);
+		}
+
+		UNITTEST_TEST(parse_invalid)
+		{
+			uuid_t id("A0B1C2D3-AACC-88EE-FF44-5566AADD2200");
+			CHECK_FALSE(id.tryParse("A0B1C2D3-AACC-88EE-FF44-5566AADD22G0"));
+			CHECK_FALSE(id.tryParse("A0B1C2D3-AACC-88EE-FF445566AADD2200"));
+			CHECK_TRUE(id == uuid_t("A0B1C2D3-AACC-88EE-FF44-5566AADD2200"));
+
+			uuid_t invalid("A0B1C2D3-AACC-88EE-FF44-5566AADD22G0");
+			CHECK_TRUE(invalid.isNull());
+		}
+
+		UNITTEST_TEST(generate_from_name)
+		{
+			// RFC 4122 name-based (v3, MD5) uuid_t of "python.org" in the DNS namespace
+			uuid_generator gen;
+			uuid_t id = gen.createFromName(uuid_t::dns(), "python.org");
+			CHECK_TRUE(id == uuid_t("6fa459ea-ee8a-3ca4-894e-db77e160355e"));
+			CHECK_EQUAL(uuid_t::UUID_NAME_BASED, id.version());
+		}
+
 		UNITTEST_TEST(generate_1)
 		{
 			uuid_generator gen;
 			uuid_t id = gen.create();
 			CHECK_FALSE(id.isNull());
 		}
+
+		UNITTEST_TEST(generate_unique)
+		{
+			// create() is called far more often than the 100 ns clock ticks
+			static const s32 cCount = 200000;
+
+			alloc_t* allocator = context_t::system_alloc();
+			uuid_t*  ids       = (uuid_t*)allocator->allocate(sizeof(uuid_t) * cCount, 16);
+
+			uuid_generator gen;
+			for (s32 i = 0; i < cCount; ++i)
+				ids[i] = gen.create();
+
+			CHECK_EQUAL(0, ntest::countDuplicates(ids, cCount));
+
+			allocator->deallocate(ids);
+		}
+
+		UNITTEST_TEST(generate_after_snapshot_restore)
+		{
+			uuid_generator gen;
+			uuid_t id1 = gen.create();
+			uuid_t id2 = gen.create();
+			CHECK_EQUAL(id1.lower(), id2.lower());
+
+			uuid_generator::notifySnapshotRestored();
+			uuid_t id3 = gen.create();
+			CHECK_EQUAL(uuid_t::UUID_TIME_BASED, id3.version());
+			CHECK_EQUAL(2, id3.variant());
+			CHECK_NOT_EQUAL(id1.lower(), id3.lower());
+		}
+
+#if defined(TARGET_LINUX)
+		UNITTEST_TEST(generate_after_fork)
+		{
+			// The child inherits the generator, its fork handler makes it pick another clock sequence
+			uuid_generator gen;
+			uuid_t const   before = gen.create();
+
+			int fds[2];
+			CHECK_EQUAL(0, pipe(fds));
+			pid_t const pid = fork();
+			CHECK_TRUE(pid >= 0);
+			if (pid == 0)
+			{
+				u8 bytes[16];
+				gen.create().copyTo(bytes);
+				_exit(write(fds[1], bytes, 16) == 16 ? 0 : 1);
+			}
+
+			uuid_t const parent = gen.create();
+			close(fds[1]);
+			u8        bytes[16];
+			s32 const n = (s32)read(fds[0], bytes, 16);
+			close(fds[0]);
+			int status = 0;
+			waitpid(pid, &status, 0);
+			CHECK_EQUAL(16, n);
+			CHECK_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+			uuid_t child;
+			child.copyFrom(bytes);
+			CHECK_EQUAL(uuid_t::UUID_TIME_BASED, child.version());
+			CHECK_EQUAL(before.lower(), parent.lower());
+			CHECK_NOT_EQUAL(parent.lower(), child.lower());
+		}
+#endif
+
+		UNITTEST_TEST(generate_with_state_file)
+		{
+			uuid_generator gen1;
+			CHECK_TRUE(gen1.attachStateFile("cuuid_test_state.bin"));
+			uuid_t id1 = gen1.create();
+			gen1.detachStateFile();
+
+			uuid_generator gen2;
+			CHECK_TRUE(gen2.attachStateFile("cuuid_test_state.bin"));
+			uuid_t id2 = gen2.create();
+			gen2.detachStateFile();
+			remove("cuuid_test_state.bin");
+
+			// The clock sequence continues, or advances by one when the clock did not move forward
+			u16 const seq1 = u16(id1.lower() >> 48) & 0x3FFF;
+			u16 const seq2 = u16(id2.lower() >> 48) & 0x3FFF;
+			CHECK_TRUE(seq2 == seq1 || seq2 == ((seq1 + 1) & 0x3FFF));
+		}
 	}
 }
 UNITTEST_SUITE_END
@@ -0,0 +1,291 @@
+#include "cbase/c_runes.h"
+#include "cuuid/c_uuid.h"
+#include "cunittest/cunittest.h"
+
+using namespace ncore;
+
+// Randomized differential tests: every case is checked against a simple
+// byte-array reference model of the uuid_t layout (RFC 4122, network byte
+// order). By default this is a quick pass that keeps cuuid_test fast, build
+// with CUUID_DIFFTEST_FULL defined for the full run of about 4 million cases.
+namespace ndifferential
+{
+#if defined(CUUID_DIFFTEST_FULL)
+    static const s32 cCases       = 1 << 20;
+    static const s32 cStringCases = 1 << 16;
+#else
+    static const s32 cCases       = 1 << 14;
+    static const s32 cStringCases = 1 << 10;
+#endif
+
+    // xorshift128+, fast and deterministic so that a failure can be replayed
+    struct random_t
+    {
+        u64 m_s0;
+        u64 m_s1;
+
+        random_t(u64 seed)
+            : m_s0(seed ^ 0x9E3779B97F4A7C15ull)
+            , m_s1((seed << 1) ^ 0xBF58476D1CE4E5B9ull)
+        {
+        }
+
+        u64 next()
+        {
+            u64       s1 = m_s0;
+            u64 const s0 = m_s1;
+            m_s0         = s0;
+            s1 ^= s1 << 23;
+            m_s1 = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+            return m_s1 + s0;
+        }
+
+        void bytes(u8* dst)
+        {
+            u64 const a = next();
+            u64 const b = next();
+            for (s32 i = 0; i < 8; ++i)
+            {
+                dst[i]     = u8(a >> (i * 8));
+                dst[i + 8] = u8(b >> (i * 8));
+            }
+        }
+    };
+
+    static u64 ref_word(const u8* bytes)
+    {
+        u64 w = 0;
+        for (s32 i = 0; i < 8; ++i)
+            w = (w << 8) | bytes[i];
+        return w;
+    }
+
+    static void ref_format(const u8* bytes, char* str)
+    {
+        const char* digits = "0123456789ABCDEF";
+        for (s32 i = 0; i < 16; ++i)
+        {
+            if (i == 4 || i == 6 || i == 8 || i == 10)
+                *str++ = '-';
+            *str++ = digits[bytes[i] >> 4];
+            *str++ = digits[bytes[i] & 0xF];
+        }
+        *str = 0;
+    }
+
+    static s32 ref_hex(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool ref_parse(const char* str, u8* bytes)
+    {
+        s32 n = 0;
+        for (s32 i = 0; i < 36; ++i)
+        {
+            if (i == 8 || i == 13 || i == 18 || i == 23)
+            {
+                if (str[i] != '-')
+                    return false;
+                continue;
+            }
+            s32 const d = ref_hex(str[i]);
+            if (d < 0)
+                return false;
+            if ((n & 1) == 0)
+                bytes[n >> 1] = u8(d << 4);
+            else
+                bytes[n >> 1] |= u8(d);
+            n++;
+        }
+        return true;
+    }
+
+    static s32 ref_compare(const u8* a, const u8* b)
+    {
+        for (s32 i = 0; i < 16; ++i)
+        {
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static s32 ref_variant(const u8* bytes)
+    {
+        s32 const v = bytes[8] >> 5;
+        if ((v & 6) == 6)
+            return v;
+        return (v & 4) ? 2 : 0;
+    }
+
+    static bool equal(const u8* a, const u8* b, s32 size)
+    {
+        for (s32 i = 0; i < size; ++i)
+        {
+            if (a[i] != b[i])
+                return false;
+        }
+        return true;
+    }
+}  // namespace ndifferential
+
+using namespace ndifferential;
+
+UNITTEST_SUITE_BEGIN(uuid_differential)
+{
+    UNITTEST_FIXTURE(main)
+    {
+        UNITTEST_FIXTURE_SETUP() {}
+        UNITTEST_FIXTURE_TEARDOWN() {}
+
+        UNITTEST_TEST(copy_round_trip)
+        {
+            random_t rnd(1);
+            s32      failures = 0;
+            for (s32 i = 0; i < cCases; ++i)
+            {
+                u8 bytes[16];
+                rnd.bytes(bytes);
+
+                uuid_t id;
+                id.copyFrom(bytes);
+                u8 copy[16];
+                id.copyTo(copy);
+
+                failures += equal(bytes, copy, 16) ? 0 : 1;
+                failures += (id.upper() == ref_word(bytes) && id.lower() == ref_word(bytes + 8)) ? 0 : 1;
+                failures += (s32(id.version()) == (bytes[6] >> 4)) ? 0 : 1;
+                failures += (id.variant() == ref_variant(bytes)) ? 0 : 1;
+            }
+            CHECK_EQUAL(0, failures);
+        }
+
+        UNITTEST_TEST(format_parse_round_trip)
+        {
+            random_t rnd(2);
+            s32      failures = 0;
+            for (s32 i = 0; i < cCases; ++i)
+            {
+                u8 bytes[16];
+                rnd.bytes(bytes);
+                uuid_t id;
+                id.copyFrom(bytes);
+
+                char expected[40];
+                ref_format(bytes, expected);
+                char str[40];
+                id.toChars(str);
+                str[36] = 0;
+                failures += equal((const u8*)expected, (const u8*)str, 37) ? 0 : 1;
+
+                uuid_t parsed;
+                failures += parsed.tryParse(str) ? 0 : 1;
+                failures += (parsed == id) ? 0 : 1;
+                failures += (parsed.version() == id.version() && parsed.variant() == id.variant()) ? 0 : 1;
+            }
+            CHECK_EQUAL(0, failures);
+        }
+
+        UNITTEST_TEST(to_string_matches_to_chars)
+        {
+            random_t rnd(3);
+            s32      failures = 0;
+            for (s32 i = 0; i < cStringCases; ++i)
+            {
+                u8 bytes[16];
+                rnd.bytes(bytes);
+                uuid_t id;
+                id.copyFrom(bytes);
+
+                char    text[64];
+                runes_t str(text, 0, 0, 63);
+                id.toString(str);
+                char chars[40];
+                id.toChars(chars);
+
+                failures += (str.size() == 36 && equal((const u8*)&str.m_ascii.m_bos[str.m_ascii.m_str], (const u8*)chars, 36)) ? 0 : 1;
+            }
+            CHECK_EQUAL(0, failures);
+        }
+
+        UNITTEST_TEST(parse_mutated_strings)
+        {
+            const char* alphabet = "0123456789abcdefABCDEF-gG xZ";
+            random_t    rnd(4);
+            s32         failures = 0;
+            for (s32 i = 0; i < cCases; ++i)
+            {
+                u8 bytes[16];
+                rnd.bytes(bytes);
+                char str[40];
+                ref_format(bytes, str);
+
+                u64 const r   = rnd.next();
+                s32 const pos = s32(r % 36);
+                str[pos]      = alphabet[(r >> 8) % 28];
+
+                u8         expected[16];
+                bool const valid = ref_parse(str, expected);
+
+                uuid_t id;
+                id.copyFrom(bytes);
+                uuid_t const before = id;
+                bool const   parsed = id.tryParse(str);
+
+                failures += (parsed == valid) ? 0 : 1;
+                if (valid)
+                {
+                    u8 actual[16];
+                    id.copyTo(actual);
+                    failures += equal(expected, actual, 16) ? 0 : 1;
+                }
+                else
+                {
+                    failures += (id == before) ? 0 : 1;
+                }
+            }
+            CHECK_EQUAL(0, failures);
+        }
+
+        UNITTEST_TEST(ordering_matches_bytes)
+        {
+            random_t rnd(5);
+            s32      failures = 0;
+            for (s32 i = 0; i < cCases; ++i)
+            {
+                u8 a[16];
+                u8 b[16];
+                rnd.bytes(a);
+
+                // Mostly share a prefix, so that every field gets compared
+                u64 const r = rnd.next();
+                for (s32 j = 0; j < 16; ++j)
+                    b[j] = a[j];
+                if ((r & 7) != 0)
+                    b[(r >> 3) % 16] = u8(r >> 16);
+                else
+                    rnd.bytes(b);
+
+                uuid_t ida;
+                uuid_t idb;
+                ida.copyFrom(a);
+                idb.copyFrom(b);
+
+                s32 const c = ref_compare(a, b);
+                failures += ((ida < idb) == (c < 0)) ? 0 : 1;
+                failures += ((ida > idb) == (c > 0)) ? 0 : 1;
+                failures += ((ida == idb) == (c == 0)) ? 0 : 1;
+                failures += ((ida.upper() < idb.upper() || (ida.upper() == idb.upper() && ida.lower() < idb.lower())) == (c < 0)) ? 0 : 1;
+            }
+            CHECK_EQUAL(0, failures);
+        }
+    }
+}
+UNITTEST_SUITE_END
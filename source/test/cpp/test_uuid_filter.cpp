@@ -0,0 +1,154 @@
+#include "cbase/c_allocator.h"
+#include "cbase/c_context.h"
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_filter.h"
+#include "cuuid/c_uuid_generator.h"
+#include "cunittest/cunittest.h"
+
+using namespace ncore;
+
+static const s32 cCount = 1000;
+static uuid_t    sIds[cCount];
+static uuid_t    sOthers[cCount];
+static bool      sResults[cCount];
+
+UNITTEST_SUITE_BEGIN(uuid_filter)
+{
+    UNITTEST_FIXTURE(main)
+    {
+        UNITTEST_FIXTURE_SETUP()
+        {
+            uuid_generator gen;
+            for (s32 i = 0; i < cCount; ++i)
+            {
+                sIds[i]    = gen.createRandom();
+                sOthers[i] = gen.createRandom();
+            }
+        }
+
+        UNITTEST_FIXTURE_TEARDOWN() {}
+
+        UNITTEST_TEST(bloom_no_false_negatives)
+        {
+            uuid_bloom_filter filter;
+            CHECK_TRUE(filter.init(context_t::system_alloc(), cCount));
+            for (s32 i = 0; i < cCount; ++i)
+                filter.insert(sIds[i]);
+
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_TRUE(filter.contains(sIds[i]));
+
+            filter.containsBatch(sIds, cCount, sResults);
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_TRUE(sResults[i]);
+
+            s32 falsePositives = 0;
+            for (s32 i = 0; i < cCount; ++i)
+                falsePositives += filter.contains(sOthers[i]) ? 1 : 0;
+            CHECK_TRUE(falsePositives < 50);
+        }
+
+        UNITTEST_TEST(bloom_serialize_attach)
+        {
+            alloc_t*          allocator = context_t::system_alloc();
+            uuid_bloom_filter filter;
+            filter.init(allocator, cCount);
+            for (s32 i = 0; i < cCount; ++i)
+                filter.insert(sIds[i]);
+
+            u32 const size   = (u32)filter.serializedSize();
+            u8*       buffer = (u8*)allocator->allocate(size, 64);
+            filter.serialize(buffer);
+
+            uuid_bloom_filter view;
+            CHECK_TRUE(view.attach(buffer, size));
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_EQUAL(filter.contains(sOthers[i]), view.contains(sOthers[i]));
+            CHECK_FALSE(view.attach(buffer, size - 1));
+
+            // A block count whose byte size wraps around 64 bits
+            *(u64*)(buffer + 16) = ((u64)1 << 58) + 1;
+            CHECK_FALSE(view.attach(buffer, size));
+
+            view.release();
+            allocator->deallocate(buffer);
+        }
+
+        UNITTEST_TEST(fuse_no_false_negatives)
+        {
+            uuid_fuse_filter filter;
+            CHECK_TRUE(filter.build(context_t::system_alloc(), sIds, cCount));
+
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_TRUE(filter.contains(sIds[i]));
+
+            filter.containsBatch(sIds, cCount, sResults);
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_TRUE(sResults[i]);
+
+            s32 falsePositives = 0;
+            for (s32 i = 0; i < cCount; ++i)
+                falsePositives += filter.contains(sOthers[i]) ? 1 : 0;
+            CHECK_TRUE(falsePositives < 20);
+        }
+
+        UNITTEST_TEST(fuse_duplicates)
+        {
+            uuid_t ids[4];
+            ids[0] = sIds[0];
+            ids[1] = sIds[1];
+            ids[2] = sIds[0];
+            ids[3] = sIds[2];
+
+            uuid_fuse_filter filter;
+            CHECK_TRUE(filter.build(context_t::system_alloc(), ids, 4));
+            for (s32 i = 0; i < 4; ++i)
+                CHECK_TRUE(filter.contains(ids[i]));
+        }
+
+        UNITTEST_TEST(fuse_too_many_keys)
+        {
+            // Rejected up front, the keys are never read.
+            uuid_fuse_filter filter;
+            CHECK_FALSE(filter.build(context_t::system_alloc(), sIds, 0x80000000u));
+            CHECK_FALSE(filter.contains(sIds[0]));
+        }
+
+        UNITTEST_TEST(fuse_serialize_attach)
+        {
+            alloc_t*         allocator = context_t::system_alloc();
+            uuid_fuse_filter filter;
+            filter.build(allocator, sIds, cCount);
+
+            u32 const size   = (u32)filter.serializedSize();
+            u8*       buffer = (u8*)allocator->allocate(size, 64);
+            filter.serialize(buffer);
+
+            uuid_fuse_filter view;
+            CHECK_TRUE(view.attach(buffer, size));
+            for (s32 i = 0; i < cCount; ++i)
+                CHECK_TRUE(view.contains(sIds[i]));
+            CHECK_FALSE(view.attach(buffer, size - 1));
+
+            // Segments whose array length wraps around 32 bits: count, segment
+            // length, segment count and array length follow magic, version and seed
+            u32 const segmentLength = 262144;
+            u32 const segmentCount  = (1 << 14) - 2;
+            *(u64*)(buffer + 16)    = (u64)segmentCount * segmentLength;
+            *(u32*)(buffer + 24)    = segmentLength;
+            *(u32*)(buffer + 28)    = segmentCount;
+            *(u32*)(buffer + 32)    = (segmentCount + 2) * segmentLength;
+            CHECK_FALSE(view.attach(buffer, size));
+
+            *(u32*)(buffer + 24) = segmentLength * 2;
+            *(u32*)(buffer + 28) = 1;
+            *(u64*)(buffer + 16) = (u64)segmentLength * 2;
+            *(u32*)(buffer + 32) = 0;
+            CHECK_FALSE(view.attach(buffer, size));
+
+            view.release();
+            allocator->deallocate(buffer);
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,81 @@
+#include "cbase/c_context.h"
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_generator.h"
+#include "cuuid/c_uuid_intern.h"
+#include "cunittest/cunittest.h"
+
+using namespace ncore;
+
+UNITTEST_SUITE_BEGIN(uuid_intern)
+{
+    UNITTEST_FIXTURE(main)
+    {
+        UNITTEST_FIXTURE_SETUP() {}
+        UNITTEST_FIXTURE_TEARDOWN() {}
+
+        UNITTEST_TEST(intern_shares_string)
+        {
+            uuid_intern_table table;
+            CHECK_TRUE(table.init(context_t::system_alloc(), 64));
+
+            uuid_generator gen;
+            uuid_t const   id1 = gen.createRandom();
+            uuid_t const   id2 = gen.createRandom();
+
+            const char* str1 = table.intern(id1);
+            const char* str2 = table.intern(id2);
+            CHECK_TRUE(str1 != nullptr);
+            CHECK_TRUE(str2 != nullptr);
+            CHECK_TRUE(str1 != str2);
+            CHECK_TRUE(table.intern(id1) == str1);
+            CHECK_TRUE(table.find(id2) == str2);
+            CHECK_EQUAL(2, table.size());
+
+            CHECK_EQUAL('-', str1[8]);
+            CHECK_EQUAL(0, str1[36]);
+            CHECK_TRUE(uuid_intern_table::toUuid(str1) == id1);
+            CHECK_TRUE(uuid_intern_table::toUuid(str2) == id2);
+        }
+
+        UNITTEST_TEST(intern_beyond_capacity)
+        {
+            uuid_intern_table table;
+            table.init(context_t::system_alloc(), 16, 1024);
+
+            uuid_generator gen;
+            uuid_t const   first = gen.createRandom();
+            const char*    str   = table.intern(first);
+            for (s32 i = 1; i < 16; ++i)
+                CHECK_TRUE(table.intern(gen.createRandom()) != nullptr);
+            CHECK_EQUAL(16, table.size());
+
+            // Full, new uuid_t's are refused, interned ones are still shared
+            for (s32 i = 0; i < 100; ++i)
+                CHECK_TRUE(table.intern(gen.createRandom()) == nullptr);
+            CHECK_EQUAL(16, table.size());
+            CHECK_TRUE(table.intern(first) == str);
+
+            table.newEpoch();
+            CHECK_TRUE(table.intern(gen.createRandom()) != nullptr);
+        }
+
+        UNITTEST_TEST(new_epoch)
+        {
+            uuid_intern_table table;
+            table.init(context_t::system_alloc(), 64);
+
+            uuid_generator gen;
+            uuid_t const   id  = gen.createRandom();
+            const char*    str = table.intern(id);
+
+            table.newEpoch();
+            CHECK_EQUAL(0, table.size());
+            CHECK_TRUE(table.find(id) == nullptr);
+
+            // Still valid during the next epoch
+            CHECK_TRUE(uuid_intern_table::toUuid(str) == id);
+            CHECK_TRUE(table.intern(id) != nullptr);
+        }
+    }
+}
+UNITTEST_SUITE_END
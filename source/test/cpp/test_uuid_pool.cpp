@@ -0,0 +1,110 @@
+#include "cbase/c_allocator.h"
+#include "cbase/c_console.h"
+#include "cbase/c_context.h"
+#include "cbase/c_runes.h"
+#include "cbase/c_printf.h"
+#include "cbase/c_va_list.h"
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_pool.h"
+#include "ctime/c_datetime.h"
+#include "cunittest/cunittest.h"
+#include "test_uuid_unique.h"
+
+#include <thread>
+
+using namespace ncore;
+
+UNITTEST_SUITE_BEGIN(uuid_pool)
+{
+    UNITTEST_FIXTURE(main)
+    {
+        UNITTEST_FIXTURE_SETUP() {}
+        UNITTEST_FIXTURE_TEARDOWN() {}
+
+        UNITTEST_TEST(version_and_variant)
+        {
+            uuid_pool v4(uuid_t::UUID_RANDOM);
+            uuid_t    id = v4.allocate();
+            CHECK_EQUAL(uuid_t::UUID_RANDOM, id.version());
+            CHECK_EQUAL(2, id.variant());
+
+            uuid_pool v8(uuid_t::UUID_CUSTOM);
+            id = v8.allocate();
+            CHECK_EQUAL(uuid_t::UUID_CUSTOM, id.version());
+            CHECK_EQUAL(2, id.variant());
+        }
+
+        UNITTEST_TEST(sequential_unique)
+        {
+            // Several threads allocate many blocks each, across reseeds.
+            static const s32 cThreads   = 4;
+            static const s32 cPerThread = 50000;
+
+            alloc_t*  allocator = context_t::system_alloc();
+            uuid_t*   ids       = (uuid_t*)allocator->allocate(sizeof(uuid_t) * cThreads * cPerThread, 16);
+            uuid_pool pool(uuid_t::UUID_RANDOM, 16384);
+
+            std::thread threads[cThreads];
+            for (s32 t = 0; t < cThreads; ++t)
+                threads[t] = std::thread([&pool, ids, t]() {
+                    for (s32 i = 0; i < cPerThread; ++i)
+                        ids[t * cPerThread + i] = pool.allocate();
+                });
+            for (s32 t = 0; t < cThreads; ++t)
+                threads[t].join();
+
+            CHECK_EQUAL(0, ntest::countDuplicates(ids, cThreads * cPerThread));
+
+            allocator->deallocate(ids);
+        }
+
+        UNITTEST_TEST(reseed)
+        {
+            // Sequence numbers 0 to 2047 (two blocks) share the initial seed,
+            // the block holding 2048 is the first to get a new one.
+            uuid_pool    pool(uuid_t::UUID_RANDOM, 2048);
+            uuid_t const first = pool.allocate();
+            for (s32 i = 1; i < 2047; ++i)
+                CHECK_EQUAL(first.upper(), pool.allocate().upper());
+            uuid_t const end = pool.allocate();
+            CHECK_EQUAL(first.upper(), end.upper());
+            uuid_t const next = pool.allocate();
+            CHECK_NOT_EQUAL(first.upper(), next.upper());
+            CHECK_EQUAL(uuid_t::UUID_RANDOM, next.version());
+        }
+
+        UNITTEST_TEST(pools_are_independent)
+        {
+            uuid_pool    a;
+            uuid_pool    b;
+            uuid_t const ida  = a.allocate();
+            uuid_t const idb  = b.allocate();
+            uuid_t const ida2 = a.allocate();
+            CHECK_TRUE(ida != idb);
+            CHECK_TRUE(ida != ida2);
+        }
+
+        UNITTEST_TEST(benchmark)
+        {
+            static const u64 cCount = 10000000;
+
+            uuid_pool pool;
+            u64       sink = 0;
+
+            datetime_t const start = datetime_t::sNow();
+            for (u64 i = 0; i < cCount; ++i)
+                sink += pool.allocate().lower();
+            datetime_t const end = datetime_t::sNow();
+            CHECK_NOT_EQUAL(0, sink);
+
+            // datetime_t ticks are 100 ns, report in 1/100 ns per allocation
+            u64 const centiNs = ((end.toBinary() - start.toBinary()) * 100 * 100) / cCount;
+
+            char    text[64] = {0};
+            runes_t str(text, 0, 0, 63);
+            sprintf(str, crunes_t("uuid_pool::allocate: %u.%02u ns"), va_t((u32)(centiNs / 100)), va_t((u32)(centiNs % 100)));
+            ncore::console->writeLine(text);
+        }
+    }
+}
+UNITTEST_SUITE_END
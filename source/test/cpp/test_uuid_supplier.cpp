@@ -0,0 +1,114 @@
+#include "cbase/c_allocator.h"
+#include "cbase/c_context.h"
+#include "cuuid/c_uuid.h"
+#include "cuuid/c_uuid_generator.h"
+#include "cuuid/c_uuid_supplier.h"
+#include "cunittest/cunittest.h"
+#include "test_uuid_unique.h"
+
+#include <thread>
+
+using namespace ncore;
+
+// Several consumers drain a small ring, so take() mixes ring and fallback
+// uuid_t's, returns the number of duplicates plus wrong versions
+static s32 take_concurrently(uuid_t::Version version)
+{
+    static const s32 cThreads   = 4;
+    static const s32 cPerThread = 10000;
+
+    alloc_t* allocator = context_t::system_alloc();
+    uuid_t*  ids       = (uuid_t*)allocator->allocate(sizeof(uuid_t) * cThreads * cPerThread, 16);
+
+    uuid_supplier supplier;
+    supplier.start(allocator, version, 64, 16, 64);
+
+    std::thread threads[cThreads];
+    for (s32 t = 0; t < cThreads; ++t)
+        threads[t] = std::thread([&supplier, ids, t]() {
+            for (s32 i = 0; i < cPerThread; ++i)
+                ids[t * cPerThread + i] = supplier.take();
+        });
+    for (s32 t = 0; t < cThreads; ++t)
+        threads[t].join();
+    supplier.stop();
+
+    s32 duplicates = ntest::countDuplicates(ids, cThreads * cPerThread);
+    for (s32 i = 0; i < cThreads * cPerThread; ++i)
+        duplicates += (ids[i].version() != version) ? 1 : 0;
+
+    allocator->deallocate(ids);
+    return duplicates;
+}
+
+UNITTEST_SUITE_BEGIN(uuid_supplier)
+{
+    UNITTEST_FIXTURE(main)
+    {
+        UNITTEST_FIXTURE_SETUP() {}
+        UNITTEST_FIXTURE_TEARDOWN() {}
+
+        UNITTEST_TEST(bulk_generate)
+        {
+            uuid_generator gen;
+            uuid_t         ids[40];
+            gen.createRandom(ids, 40);
+            for (s32 i = 0; i < 40; ++i)
+            {
+                CHECK_EQUAL(uuid_t::UUID_RANDOM, ids[i].version());
+                CHECK_EQUAL(2, ids[i].variant());
+            }
+
+            gen.create(ids, 40);
+            for (s32 i = 1; i < 40; ++i)
+                CHECK_TRUE(ids[i - 1] != ids[i]);
+        }
+
+        UNITTEST_TEST(start_fills_ring)
+        {
+            uuid_supplier supplier;
+            CHECK_TRUE(supplier.start(context_t::system_alloc(), uuid_t::UUID_RANDOM, 256, 64, 256));
+            CHECK_EQUAL(256, supplier.available());
+            supplier.stop();
+        }
+
+        UNITTEST_TEST(take_random)
+        {
+            uuid_supplier supplier;
+            supplier.start(context_t::system_alloc(), uuid_t::UUID_RANDOM, 64, 16, 64);
+
+            uuid_t prev = supplier.take();
+            for (s32 i = 0; i < 1000; ++i)
+            {
+                uuid_t const id = supplier.take();
+                CHECK_EQUAL(uuid_t::UUID_RANDOM, id.version());
+                CHECK_TRUE(id != prev);
+                prev = id;
+            }
+            supplier.stop();
+        }
+
+        UNITTEST_TEST(take_time_based)
+        {
+            uuid_supplier supplier;
+            supplier.start(context_t::system_alloc(), uuid_t::UUID_TIME_BASED, 64, 16, 64);
+
+            uuid_t prev = supplier.take();
+            for (s32 i = 0; i < 1000; ++i)
+            {
+                uuid_t const id = supplier.take();
+                CHECK_EQUAL(uuid_t::UUID_TIME_BASED, id.version());
+                CHECK_TRUE(id != prev);
+                prev = id;
+            }
+            supplier.stop();
+        }
+
+        UNITTEST_TEST(take_concurrent_unique)
+        {
+            CHECK_EQUAL(0, take_concurrently(uuid_t::UUID_RANDOM));
+            CHECK_EQUAL(0, take_concurrently(uuid_t::UUID_TIME_BASED));
+        }
+    }
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,28 @@
+#ifndef __CUUID_TEST_UUID_UNIQUE_H__
+#define __CUUID_TEST_UUID_UNIQUE_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#    pragma once
+#endif
+
+#include "cuuid/c_uuid.h"
+
+#include <algorithm>
+
+namespace ncore
+{
+    namespace ntest
+    {
+        // Sorts the uuid_t's in place and returns the number of duplicates
+        inline s32 countDuplicates(uuid_t* ids, s32 count)
+        {
+            std::sort(ids, ids + count);
+            s32 duplicates = 0;
+            for (s32 i = 1; i < count; ++i)
+                duplicates += (ids[i - 1] == ids[i]) ? 1 : 0;
+            return duplicates;
+        }
+    }  // namespace ntest
+}  // namespace ncore
+
+#endif  // __CUUID_TEST_UUID_UNIQUE_H__